@@ -0,0 +1,167 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+
+#include <include/bigfraction.hpp>
+#include <include/dyn_matrix.hpp>
+#include <include/matrix.hpp>
+
+// Counts heap allocations made while evaluating matrix expressions, for
+// heap-backed DynMatrix and for fixed-size matrices of BigFraction cells
+
+size_t allocations = 0;
+
+void *operator new(size_t size)
+{
+    ++allocations;
+    if (void *p = malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void *operator new(size_t size, std::align_val_t align)
+{
+    ++allocations;
+    const size_t a = (size_t)align;
+    if (void *p = aligned_alloc(a, (size + a - 1) / a * a))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept
+{
+    free(p);
+}
+
+/// @brief Prints allocations and time per evaluation of an expression
+/// @param name Expression
+/// @param minimum Allocations the result itself needs, negative when it depends on the cells
+/// @param f Evaluates the expression
+template <typename F>
+void count(const char *name, const long &minimum, F &&f)
+{
+    // Warm up, so one-time allocations are not counted
+    f();
+
+    const size_t reps = 20;
+    const size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; ++r)
+        f();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "  " << name << ": " << (allocations - before) / reps << " allocations";
+    if (minimum >= 0)
+        std::cout << " (minimum " << minimum << ")";
+    std::cout << ", " << std::chrono::duration<double, std::micro>(end - start).count() / reps << " us\n";
+}
+
+void runDynamic()
+{
+    const size_t o = 256;
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+
+    DynMatrix<double> A{o, o}, B{o, o}, C{o, o}, D{o, o};
+    for (auto *m : {&A, &B, &C, &D})
+    {
+        for (size_t i = 0; i < o; ++i)
+        {
+            for (size_t j = 0; j < o; ++j)
+            {
+                (*m)[i][j] = dist(rng);
+            }
+        }
+    }
+
+    DynMatrix<double> res;
+    double sink = 0;
+
+    std::cout << "DynMatrix<double> " << o << "x" << o << "\n";
+    count("A + B                ", 1, [&]
+          { res = A + B; sink += res[0][0]; });
+    count("A + B + C + D        ", 1, [&]
+          { res = A + B + C + D; sink += res[0][0]; });
+    count("A - B - C            ", 1, [&]
+          { res = A - B - C; sink += res[0][0]; });
+    count("A - (B + C)          ", 1, [&]
+          { res = A - (B + C); sink += res[0][0]; });
+    count("(A + B) - (C + D)    ", 2, [&]
+          { res = (A + B) - (C + D); sink += res[0][0]; });
+    count("-(A + B) * 2 / 3     ", 1, [&]
+          { res = -(A + B) * 2.0 / 3.0; sink += res[0][0]; });
+    count("2 * (A - B)          ", 1, [&]
+          { res = 2.0 * (A - B); sink += res[0][0]; });
+    count("A * B + C            ", 1, [&]
+          { res = A * B + C; sink += res[0][0]; });
+    count("res -= A             ", 0, [&]
+          { res -= A; sink += res[0][0]; });
+
+    // Keep results alive
+    if (sink == 0.5)
+        std::cout << sink << "\n";
+}
+
+void runBig()
+{
+    // Numerators and denominators above 64 bits, so every cell owns heap limbs
+    const size_t o = 4;
+    std::mt19937 rng{1234};
+    const BigInt wide = BigInt{INT64_MAX} * BigInt{INT64_MAX};
+
+    Matrix<o, o, BigFraction> A{}, B{}, C{}, D{};
+    for (auto *m : {&A, &B, &C, &D})
+    {
+        for (size_t i = 0; i < o; ++i)
+        {
+            for (size_t j = 0; j < o; ++j)
+            {
+                m->data[i][j] = BigFraction{wide + BigInt{(int64_t)rng()}, BigInt{(int64_t)rng() + 1}};
+            }
+        }
+    }
+
+    Matrix<o, o, BigFraction> res;
+    BigFraction sink{0};
+
+    std::cout << "Matrix<" << o << ", " << o << ", BigFraction>\n";
+    count("A + B                ", -1, [&]
+          { res = A + B; sink += res.data[0][0]; });
+    count("A + B + C + D        ", -1, [&]
+          { res = A + B + C + D; sink += res.data[0][0]; });
+    count("A - B - C            ", -1, [&]
+          { res = A - B - C; sink += res.data[0][0]; });
+    count("-(A + B) * 2         ", -1, [&]
+          { res = -(A + B) * BigFraction{2}; sink += res.data[0][0]; });
+    count("res -= A             ", -1, [&]
+          { res -= A; sink += res.data[0][0]; });
+
+    // Keep results alive
+    if (sink == BigFraction{-1})
+        std::cout << sink << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    runDynamic();
+    runBig();
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+
+// Compares Gauss-Jordan against Bareiss fraction-free elimination on the
+// 10x10 integer matrices from main.cpp, counting GCD evaluations and wall time
+
+const size_t o = 10;
+const size_t samples = 2000;
+
+template <typename F>
+double measure(const char *name, uint64_t &gcds, F &&f)
+{
+    fractionGcdCount = 0;
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    gcds = fractionGcdCount;
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << "  " << name << ": " << ms << " ms, " << gcds << " GCD calls\n";
+    return ms;
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    std::vector<Matrix<o, o, Fraction>> inputs(samples);
+    for (auto &m : inputs)
+    {
+        for (size_t i = 0; i < o; ++i)
+        {
+            for (size_t j = 0; j < o; ++j)
+            {
+                m.data[i][j] = (int64_t)(rng() % 10) - 5;
+            }
+        }
+    }
+
+    std::vector<Fraction> detGJ(samples), detB(samples);
+    std::vector<Matrix<o, o, Fraction>> invGJ(samples), invB(samples);
+    uint64_t gcdGJ, gcdB;
+
+    std::cout << "determinant (" << samples << " samples of " << o << "x" << o << ")\n";
+    double t0 = measure("gauss-jordan", gcdGJ, [&]
+                        { for (size_t s = 0; s < samples; ++s) detGJ[s] = rowReductionDeterminant(inputs[s]); });
+    double t1 = measure("bareiss     ", gcdB, [&]
+                        { for (size_t s = 0; s < samples; ++s) detB[s] = bareissDeterminant(inputs[s]); });
+    std::cout << "  speedup: " << t0 / t1 << "x\n";
+
+    std::cout << "inverse (" << samples << " samples of " << o << "x" << o << ")\n";
+    t0 = measure("gauss-jordan", gcdGJ, [&]
+                 { for (size_t s = 0; s < samples; ++s) invGJ[s] = gaussJordanInverse(inputs[s]); });
+    t1 = measure("bareiss     ", gcdB, [&]
+                 { for (size_t s = 0; s < samples; ++s) invB[s] = bareissInverse(inputs[s]); });
+    std::cout << "  speedup: " << t0 / t1 << "x\n";
+
+    // Bareiss must always be exact; Gauss-Jordan may silently overflow its intermediate fractions
+    const auto id = Matrix<o, o, Fraction>::identity();
+    size_t overflows = 0;
+    for (size_t s = 0; s < samples; ++s)
+    {
+        if (detB[s] != 0 && invB[s] * inputs[s] != id)
+        {
+            std::cout << "Wrong Bareiss inverse on sample " << s << "\n";
+            return 1;
+        }
+        if (detGJ[s] != detB[s] || invGJ[s] != invB[s])
+        {
+            ++overflows;
+        }
+    }
+    std::cout << "gauss-jordan results corrupted by overflow: " << overflows << "/" << samples << "\n";
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <include/batch.hpp>
+#include <include/lu.hpp>
+#include <include/matrix.hpp>
+#include <include/thread_pool.hpp>
+
+// Batched products, determinants and inverses of a million small matrices against
+// the same operations run one Matrix at a time, on one thread and on the shared pool.
+// Results are checked against LU, which pivots on magnitude and so is the most accurate
+
+template <typename F>
+double measure(F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/// @brief Largest relative difference between two values
+template <typename T>
+double difference(const T &x, const T &y)
+{
+    const double scale = std::abs(x) > 1 ? std::abs(x) : 1;
+    return std::abs(x - y) / scale;
+}
+
+template <size_t N, typename T>
+void run(const char *type, const size_t &count, std::mt19937 &rng)
+{
+    std::vector<Matrix<N, N, T>> as(count), bs(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < N; ++j)
+            {
+                as[k].data[i][j] = (T)(rng() % 2001) / 1000 - 1;
+                bs[k].data[i][j] = (T)(rng() % 2001) / 1000 - 1;
+            }
+        }
+    }
+    const MatrixBatch<N, T> a{as}, b{bs};
+    ThreadPool single{1};
+
+    // Reused batches are written in place; "batch" times include allocating the result
+
+    std::cout << type << " " << N << "x" << N << ", " << count << " matrices (ns per matrix)\n";
+
+    // Products
+    {
+        std::vector<Matrix<N, N, T>> ref(count);
+        const double tLoop = measure([&]
+                                     { for (size_t k = 0; k < count; ++k) ref[k] = as[k] * bs[k]; });
+        MatrixBatch<N, T> res{count};
+        const double tAlloc = measure([&]
+                                      { res = batchMultiply(a, b, single); });
+        const double tSingle = measure([&]
+                                       { batchMultiply(a, b, res, single); });
+        const double tShared = measure([&]
+                                       { batchMultiply(a, b, res); });
+
+        double diff = 0;
+        for (size_t k = 0; k < count; ++k)
+        {
+            const Matrix<N, N, T> m = res.get(k);
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = 0; j < N; ++j)
+                    diff = std::max(diff, difference(ref[k].data[i][j], m.data[i][j]));
+        }
+        std::cout << "  multiply:    loop " << tLoop / count << ", batch " << tAlloc / count << ", batch reused " << tSingle / count
+                  << ", batch parallel " << tShared / count << " (max diff " << diff << ")\n";
+    }
+
+    // Determinants
+    {
+        std::vector<T> ref(count);
+        const double tLoop = measure([&]
+                                     { for (size_t k = 0; k < count; ++k) ref[k] = as[k].determinant(); });
+        std::vector<T> res;
+        const double tAlloc = measure([&]
+                                      { res = batchDeterminant(a, single); });
+        const double tSingle = measure([&]
+                                       { batchDeterminant(a, res, single); });
+        const double tShared = measure([&]
+                                       { batchDeterminant(a, res); });
+
+        double diff = 0;
+        for (size_t k = 0; k < count; ++k)
+            diff = std::max(diff, difference(LU<N, T>{as[k]}.determinant(), res[k]));
+        std::cout << "  determinant: loop " << tLoop / count << ", batch " << tAlloc / count << ", batch reused " << tSingle / count
+                  << ", batch parallel " << tShared / count << " (max diff " << diff << ")\n";
+    }
+
+    // Inverses
+    {
+        std::vector<Matrix<N, N, T>> ref(count);
+        const double tLoop = measure([&]
+                                     { for (size_t k = 0; k < count; ++k) ref[k] = as[k].inverse(); });
+        MatrixBatch<N, T> res;
+        const double tAlloc = measure([&]
+                                      { res = batchInverse(a, single); });
+        const double tSingle = measure([&]
+                                       { batchInverse(a, res, single); });
+        const double tShared = measure([&]
+                                       { batchInverse(a, res); });
+
+        // Nearly singular matrices amplify rounding differences, compare well-conditioned ones only
+        double diff = 0;
+        for (size_t k = 0; k < count; ++k)
+        {
+            const LU<N, T> lu{as[k]};
+            if (std::abs(lu.determinant()) < T{0.1})
+                continue;
+
+            const Matrix<N, N, T> m = res.get(k), inv = lu.inverse();
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = 0; j < N; ++j)
+                    diff = std::max(diff, difference(inv.data[i][j], m.data[i][j]));
+        }
+        std::cout << "  inverse:     loop " << tLoop / count << ", batch " << tAlloc / count << ", batch reused " << tSingle / count
+                  << ", batch parallel " << tShared / count << " (max diff " << diff << ")\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1 << 20;
+    std::cout << "Kernels: " << simdLevelName(simdLevel()) << ", shared pool: "
+              << ThreadPool::shared().size() << " threads\n";
+
+    std::mt19937 rng{1234};
+    run<2, float>("float", count, rng);
+    run<3, float>("float", count, rng);
+    run<4, float>("float", count, rng);
+    run<2, double>("double", count, rng);
+    run<3, double>("double", count, rng);
+    run<4, double>("double", count, rng);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <include/matrix.hpp>
+
+// Cycles per call of determinant() and inverse() on float and double matrices of orders
+// 2 to 4, which now take the cofactor closed forms, against the elimination they ran before. Cycles are read from
+// the time-stamp counter where there is one, nanoseconds are printed otherwise
+
+/// @brief Time-stamp counter, or nanoseconds on targets without one
+inline uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/// @brief Ticks per call, cycling over a pool of inputs so nothing is hoisted out of the loop
+template <typename M, typename F>
+double measure(const std::vector<M> &ms, const size_t &reps, F &&f)
+{
+    const uint64_t start = ticks();
+    for (size_t r = 0; r < reps; ++r)
+        f(ms[r % ms.size()]);
+    const uint64_t end = ticks();
+
+    return (double)(end - start) / reps;
+}
+
+/// @brief Determinant by the path determinant() took before the closed forms
+template <size_t R, typename T>
+T eliminationDeterminant(const Matrix<R, R, T> &m)
+{
+    return rowReductionDeterminant(m);
+}
+
+/// @brief Inverse by the path inverse() took before the closed forms
+template <size_t R, typename T>
+Matrix<R, R, T> eliminationInverse(const Matrix<R, R, T> &m)
+{
+    return gaussJordanInverse(m);
+}
+
+template <size_t R, typename T>
+void run(const char *type, const size_t &reps, std::mt19937 &rng)
+{
+    // Nonsingular inputs only, so neither path stops early or prints
+    std::vector<Matrix<R, R, T>> ms;
+    while (ms.size() < 256)
+    {
+        Matrix<R, R, T> m{};
+        for (size_t i = 0; i < R; ++i)
+        {
+            for (size_t j = 0; j < R; ++j)
+            {
+                m.data[i][j] = (T)(rng() % 2001) / 1000 - 1;
+            }
+        }
+        if (std::abs(m.determinant()) > T{0.1})
+            ms.push_back(m);
+    }
+
+    // Both paths must agree up to rounding
+    double diff = 0;
+    for (Matrix<R, R, T> m : ms)
+    {
+        const Matrix<R, R, T> a = m.inverse(), b = eliminationInverse(m);
+        for (size_t i = 0; i < R; ++i)
+        {
+            for (size_t j = 0; j < R; ++j)
+            {
+                diff = std::max(diff, (double)std::abs(a.data[i][j] - b.data[i][j]));
+            }
+        }
+    }
+
+    // Counting nonzero results keeps every call alive
+    size_t sink = 0;
+    const double detBefore = measure(ms, reps, [&](Matrix<R, R, T> m)
+                                     { sink += eliminationDeterminant(m) != T{0}; });
+    const double detAfter = measure(ms, reps, [&](Matrix<R, R, T> m)
+                                    { sink += m.determinant() != T{0}; });
+    const double invBefore = measure(ms, reps, [&](Matrix<R, R, T> m)
+                                     { sink += eliminationInverse(m).data[0][0] != T{0}; });
+    const double invAfter = measure(ms, reps, [&](Matrix<R, R, T> m)
+                                    { sink += m.inverse().data[0][0] != T{0}; });
+
+    std::cout << type << " " << R << "x" << R << ": determinant " << detBefore << " -> " << detAfter
+              << " (" << detBefore / detAfter << "x), inverse " << invBefore << " -> " << invAfter
+              << " (" << invBefore / invAfter << "x), max diff " << diff
+              << (sink == 0 ? " " : "") << "\n";
+}
+
+int main(int argc, char **argv)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    std::cout << "Cycles per call, elimination -> closed form\n";
+#else
+    std::cout << "Nanoseconds per call, elimination -> closed form\n";
+#endif
+
+    std::mt19937 rng{1234};
+    run<2, float>("float", 2000000, rng);
+    run<3, float>("float", 2000000, rng);
+    run<4, float>("float", 2000000, rng);
+    run<2, double>("double", 2000000, rng);
+    run<3, double>("double", 2000000, rng);
+    run<4, double>("double", 2000000, rng);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+#include <include/matrix_expr.hpp>
+
+// Times eager Matrix operators against lazy expressions evaluated in a single pass
+
+template <typename F>
+double measure(const size_t &reps, F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; ++r)
+        f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+}
+
+template <size_t O, typename T>
+void fill(Matrix<O, O, T> &m, std::mt19937 &rng)
+{
+    for (size_t i = 0; i < O; ++i)
+    {
+        for (size_t j = 0; j < O; ++j)
+        {
+            if constexpr (std::is_same_v<T, Fraction>)
+                m.data[i][j] = Fraction{(int64_t)(rng() % 10) - 5, (int64_t)(rng() % 4) + 1};
+            else
+                m.data[i][j] = (T)(rng() % 1000) / 100 - 5;
+        }
+    }
+}
+
+template <size_t O, typename T>
+void run(const char *type, const size_t &reps, std::mt19937 &rng)
+{
+    // Static, so large orders don't live on the stack
+    static Matrix<O, O, T> A, B, C, D, res;
+    fill(A, rng);
+    fill(B, rng);
+    fill(C, rng);
+    fill(D, rng);
+    const T s = T{3} / T{2};
+
+    std::cout << type << " " << O << "x" << O << "\n";
+
+    const double eager0 = measure(reps, [&]
+                                  { res = A + B - C * s + D; });
+    const Matrix<O, O, T> check0 = res;
+    const double lazy0 = measure(reps, [&]
+                                 { res = lazy(A) + B - C * s + D; });
+    std::cout << "  A + B - C * s + D: eager " << eager0 << " us, lazy " << lazy0 << " us, "
+              << eager0 / lazy0 << "x" << (res == check0 ? "" : " MISMATCH") << "\n";
+
+    const double eager1 = measure(reps, [&]
+                                  { res = A * B + C - D * s; });
+    const Matrix<O, O, T> check1 = res;
+    const double lazy1 = measure(reps, [&]
+                                 { res = lazy(A) * B + C - D * s; });
+    std::cout << "  A * B + C - D * s: eager " << eager1 << " us, lazy " << lazy1 << " us, "
+              << eager1 / lazy1 << "x" << (res == check1 ? "" : " MISMATCH") << "\n";
+
+    // Aliased product, evaluated through a temporary
+    const double eager2 = measure(reps, [&]
+                                  { res = A; res = res * B; });
+    const Matrix<O, O, T> check2 = res;
+    const double lazy2 = measure(reps, [&]
+                                 { res = A; res = lazy(res) * B; });
+    std::cout << "  res = res * B    : eager " << eager2 << " us, lazy " << lazy2 << " us, "
+              << eager2 / lazy2 << "x" << (res == check2 ? "" : " MISMATCH") << "\n";
+
+    // Destination read as a later operand, evaluated through a row buffer
+    const double eager3 = measure(reps, [&]
+                                  { res = A; res = B + res; res = C - res; res = A * B + res; });
+    const Matrix<O, O, T> check3 = res;
+    const double lazy3 = measure(reps, [&]
+                                 { res = A; res = lazy(B) + res; res = lazy(C) - res; res = lazy(A) * B + res; });
+    std::cout << "  res = B + res ...: eager " << eager3 << " us, lazy " << lazy3 << " us, "
+              << eager3 / lazy3 << "x" << (res == check3 ? "" : " MISMATCH") << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    run<16, double>("double", 20000, rng);
+    run<128, double>("double", 20, rng);
+    run<4, Fraction>("Fraction", 20000, rng);
+    run<10, Fraction>("Fraction", 2000, rng);
+
+    return 0;
+}
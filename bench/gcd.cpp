@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Records every GCD evaluated by Fraction, so candidates are compared on the
+// operands that matrix inversion really produces
+std::vector<std::pair<int64_t, int64_t>> captured;
+#define FRACTION_GCD_HOOK(a, b) captured.emplace_back(a, b)
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+
+/// @brief Textbook modulo Euclid, the previous Fraction implementation
+int64_t euclidGcd(int64_t a, int64_t b)
+{
+    while (b != 0)
+    {
+        int64_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a < 0 ? -a : a;
+}
+
+/// @brief Binary GCD, stripping trailing zeros with a single count
+int64_t binaryGcd(int64_t x, int64_t y)
+{
+    uint64_t a = x < 0 ? 0 - (uint64_t)x : (uint64_t)x;
+    uint64_t b = y < 0 ? 0 - (uint64_t)y : (uint64_t)y;
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+
+    const int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b != 0)
+    {
+        b >>= __builtin_ctzll(b);
+        if (a > b)
+            std::swap(a, b);
+        b -= a;
+    }
+
+    return a << shift;
+}
+
+/// @brief Binary GCD with branchless min / absolute difference
+int64_t branchlessBinaryGcd(int64_t x, int64_t y)
+{
+    uint64_t a = x < 0 ? 0 - (uint64_t)x : (uint64_t)x;
+    uint64_t b = y < 0 ? 0 - (uint64_t)y : (uint64_t)y;
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+
+    const int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    b >>= __builtin_ctzll(b);
+    while (a != b)
+    {
+        const uint64_t d = a > b ? a - b : b - a;
+        a = std::min(a, b);
+        b = d >> __builtin_ctzll(d);
+    }
+
+    return a << shift;
+}
+
+/// @brief Binary GCD without swaps: the next shift is counted on the signed
+/// difference, in parallel with the min / abs updates
+int64_t noSwapBinaryGcd(int64_t x, int64_t y)
+{
+    uint64_t a = x < 0 ? 0 - (uint64_t)x : (uint64_t)x;
+    uint64_t b = y < 0 ? 0 - (uint64_t)y : (uint64_t)y;
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+
+    int az = __builtin_ctzll(a);
+    const int bz = __builtin_ctzll(b);
+    const int shift = az < bz ? az : bz;
+    b >>= bz;
+    while (a != 0)
+    {
+        a >>= az;
+        const int64_t diff = (int64_t)(b - a);
+        az = __builtin_ctzll((uint64_t)diff | (UINT64_C(1) << 63));
+        b = std::min(a, b);
+        a = diff < 0 ? 0 - (uint64_t)diff : (uint64_t)diff;
+    }
+
+    return b << shift;
+}
+
+/// @brief Standard library GCD, for reference
+int64_t stdGcd(int64_t a, int64_t b)
+{
+    return std::gcd(a, b);
+}
+
+template <size_t O>
+void captureInversions(std::mt19937 &rng, const size_t &samples)
+{
+    for (size_t s = 0; s < samples; ++s)
+    {
+        // Bareiss determinant calls no GCD, so rejecting singular samples doesn't skew the capture
+        Matrix<O, O, Fraction> m{};
+        do
+        {
+            for (size_t i = 0; i < O; ++i)
+            {
+                for (size_t j = 0; j < O; ++j)
+                {
+                    m.data[i][j] = (int64_t)(rng() % 10) - 5;
+                }
+            }
+        } while (m.determinant() == Fraction{0});
+        gaussJordanInverse(m);
+    }
+}
+
+void run(const char *distribution, const std::vector<std::pair<int64_t, int64_t>> &operands)
+{
+    const std::pair<const char *, int64_t (*)(int64_t, int64_t)> candidates[] = {
+        {"euclid           ", euclidGcd},
+        {"binary           ", binaryGcd},
+        {"branchless binary", branchlessBinaryGcd},
+        {"no-swap binary   ", noSwapBinaryGcd},
+        {"std::gcd         ", stdGcd},
+    };
+
+    std::cout << distribution << " (" << operands.size() << " pairs)\n";
+    for (const auto &c : candidates)
+    {
+        int64_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto &p : operands)
+            sink += c.second(p.first, p.second);
+        auto end = std::chrono::steady_clock::now();
+
+        // Every candidate must agree with the reference
+        int64_t expected = 0;
+        for (const auto &p : operands)
+            expected += stdGcd(p.first, p.second);
+
+        std::cout << "  " << c.first << ": "
+                  << std::chrono::duration<double, std::nano>(end - start).count() / operands.size() << " ns/call"
+                  << (sink == expected ? "" : "  MISMATCH") << "\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+
+    captureInversions<4>(rng, 20000);
+    auto small = std::move(captured);
+    captured.clear();
+    run("4x4 Gauss-Jordan inversion", small);
+
+    captureInversions<10>(rng, 500);
+    auto large = std::move(captured);
+    captured.clear();
+    run("10x10 Gauss-Jordan inversion", large);
+
+    std::mt19937_64 rng64{1234};
+    std::vector<std::pair<int64_t, int64_t>> uniform(1000000);
+    for (auto &p : uniform)
+        p = {(int64_t)(rng64() >> 1), (int64_t)(rng64() >> 1)};
+    run("uniform 63-bit", uniform);
+
+    return 0;
+}
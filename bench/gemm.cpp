@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <include/dyn_matrix.hpp>
+#include <include/gemm.hpp>
+
+// GFLOP/s of the blocked GEMM behind operator* against the naive i-j-k loop
+// it replaced, which walks down the columns of the right matrix
+
+template <typename T>
+void naiveProduct(const DynMatrix<T> &a, const DynMatrix<T> &b, DynMatrix<T> &res)
+{
+    for (size_t i = 0; i < a.rows(); ++i)
+    {
+        for (size_t j = 0; j < b.cols(); ++j)
+        {
+            T acc{0};
+            for (size_t k = 0; k < a.cols(); ++k)
+                acc += a[i][k] * b[k][j];
+            res[i][j] = acc;
+        }
+    }
+}
+
+/// @brief Runs f until at least minSeconds have passed
+/// @return Seconds per call
+template <typename F>
+double measure(const double &minSeconds, F &&f)
+{
+    size_t reps = 0;
+    double elapsed = 0;
+    auto start = std::chrono::steady_clock::now();
+    do
+    {
+        f();
+        ++reps;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < minSeconds);
+
+    return elapsed / reps;
+}
+
+template <typename T>
+void run(const char *type, const size_t &o, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<T> dist{-1, 1};
+    DynMatrix<T> A{o, o}, B{o, o}, naive{o, o}, blocked;
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            A[i][j] = dist(rng);
+            B[i][j] = dist(rng);
+        }
+    }
+
+    const double flops = 2.0 * o * o * o;
+    const double tNaive = measure(0.5, [&]
+                                  { naiveProduct(A, B, naive); });
+    const double tBlocked = measure(0.5, [&]
+                                    { blocked = A * B; });
+
+    // Both sum every cell in a different order, so compare relative to the operands' scale
+    double maxError = 0;
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+            maxError = std::max(maxError, (double)std::abs(naive[i][j] - blocked[i][j]));
+    }
+    const double tolerance = std::sqrt((double)o) * (sizeof(T) == 4 ? 1e-5 : 1e-13);
+
+    std::cout << type << " " << o << "x" << o << ": naive " << flops / tNaive * 1e-9
+              << " GFLOP/s, gemm " << flops / tBlocked * 1e-9 << " GFLOP/s, "
+              << tNaive / tBlocked << "x" << (maxError <= tolerance ? "" : " MISMATCH") << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    for (size_t o : {64, 128, 256, 512, 1024, 2048})
+        run<double>("double", o, rng);
+    for (size_t o : {64, 128, 256, 512, 1024, 2048})
+        run<float>("float", o, rng);
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <include/bigint.hpp>
+#include <include/fraction.hpp>
+#include <include/laplace.hpp>
+#include <include/matrix.hpp>
+#include <include/thread_pool.hpp>
+
+// Division-free determinants of integer matrices: the Laplace recursion over
+// every minor, O(n!), against memoized minors, O(n * 2^n), on one thread and on
+// the shared pool. Results are checked against Bareiss on the same matrix as Fractions
+
+template <typename F>
+double measure(F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <size_t R>
+void run(std::mt19937 &rng, ThreadPool &single)
+{
+    // Entries in {-1, 0, 1} keep every determinant within 64 bits
+    Matrix<R, R, int64_t> m{};
+    Matrix<R, R, Fraction> f{};
+    Matrix<R, R, BigInt> b{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < R; ++j)
+        {
+            m.data[i][j] = (int64_t)(rng() % 3) - 1;
+            f.data[i][j] = Fraction{m.data[i][j]};
+            b.data[i][j] = BigInt{m.data[i][j]};
+        }
+    }
+    const Fraction reference = f.determinant();
+
+    std::cout << "  " << R << "x" << R << ":";
+    if (R <= 11)
+    {
+        int64_t det = 0;
+        const double t = measure([&]
+                                 { det = lapLaceDeterminant(m); });
+        std::cout << " recursion " << t << " ms" << (Fraction{det} == reference ? "" : " (WRONG)") << ",";
+    }
+
+    int64_t single64 = 0, shared64 = 0;
+    BigInt big;
+    const double tSingle = measure([&]
+                                   { single64 = memoizedLapLaceDeterminant(m, single); });
+    const double tShared = measure([&]
+                                   { shared64 = memoizedLapLaceDeterminant(m); });
+    const double tBig = measure([&]
+                                { big = memoizedLapLaceDeterminant(b); });
+
+    const bool ok = Fraction{single64} == reference && Fraction{shared64} == reference && big == BigInt{single64};
+    std::cout << " memoized " << tSingle << " ms, parallel " << tShared << " ms, BigInt " << tBig
+              << " ms, determinant " << single64 << (ok ? "" : " (WRONG)") << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    ThreadPool single{1};
+    std::cout << "Division-free determinants of int64_t matrices, shared pool: "
+              << ThreadPool::shared().size() << " threads\n";
+
+    std::mt19937 rng{1234};
+    run<8>(rng, single);
+    run<10>(rng, single);
+    run<11>(rng, single);
+    run<14>(rng, single);
+    run<18>(rng, single);
+    run<20>(rng, single);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+
+// Times the main.cpp workload (4x4 and 10x10 determinant, inverse and
+// inv * A products), through both the default and the Gauss-Jordan paths,
+// plus element-wise arithmetic on integer cells
+
+const size_t samples = 2000;
+
+template <size_t O>
+std::vector<Matrix<O, O, Fraction>> randomMatrices(std::mt19937 &rng)
+{
+    std::vector<Matrix<O, O, Fraction>> res(samples);
+    for (auto &m : res)
+    {
+        // Singular samples would only measure the early exit
+        do
+        {
+            for (size_t i = 0; i < O; ++i)
+            {
+                for (size_t j = 0; j < O; ++j)
+                {
+                    m.data[i][j] = (int64_t)(rng() % 10) - 5;
+                }
+            }
+        } while (m.determinant() == Fraction{0});
+    }
+
+    return res;
+}
+
+template <typename F>
+void measure(const char *name, F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "  " << name << ": " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+}
+
+template <size_t O>
+void run(std::mt19937 &rng)
+{
+    auto inputs = randomMatrices<O>(rng);
+    std::vector<Matrix<O, O, Fraction>> invs(samples);
+    Fraction sink{0};
+
+    std::cout << O << "x" << O << " (" << samples << " samples)\n";
+    measure("determinant()          ", [&]
+            { for (auto &m : inputs) sink += m.determinant(); });
+    measure("rowReductionDeterminant", [&]
+            { for (auto &m : inputs) sink += rowReductionDeterminant(m); });
+    measure("inverse()              ", [&]
+            { for (size_t s = 0; s < samples; ++s) invs[s] = inputs[s].inverse(); });
+    measure("gaussJordanInverse     ", [&]
+            { for (size_t s = 0; s < samples; ++s) invs[s] = gaussJordanInverse(inputs[s]); });
+    measure("inv(A) * A             ", [&]
+            { for (size_t s = 0; s < samples; ++s) sink += (invs[s] * inputs[s]).data[0][0]; });
+
+    // Integer cells keep every GCD at one iteration, exposing per-call overhead
+    measure("A + A * 2 (x100)       ", [&]
+            { for (size_t r = 0; r < 100; ++r) for (auto &m : inputs) sink += (m + m * Fraction{2}).data[0][0]; });
+
+    // Keep results alive
+    if (sink == Fraction{-1, 3})
+        std::cout << sink << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    run<4>(rng);
+    run<10>(rng);
+
+    return 0;
+}
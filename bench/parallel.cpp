@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <include/dyn_matrix.hpp>
+#include <include/fraction.hpp>
+#include <include/parallel.hpp>
+
+// Scaling of the parallel product, inverse and determinant from 1 thread up to
+// every hardware thread (or the count given as first argument)
+
+template <typename F>
+double measure(F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename T>
+DynMatrix<T> randomMatrix(const size_t &o, std::mt19937 &rng)
+{
+    DynMatrix<T> m{o, o};
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            if constexpr (std::is_same_v<T, Fraction>)
+                m[i][j] = Fraction{(int64_t)(rng() % 5) - 2, (int64_t)(rng() % 2) + 1};
+            else
+                m[i][j] = (T)(rng() % 2001) / 1000 - 1;
+        }
+    }
+
+    return m;
+}
+
+/// @brief Times one operation at every thread count, comparing each result with the single-thread one
+template <typename T, typename F>
+void scale(const char *name, const size_t &maxThreads, F &&f)
+{
+    std::cout << name << "\n";
+
+    // Powers of two, then the maximum
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(maxThreads);
+
+    double base = 0;
+    T reference{};
+    for (const size_t &threads : counts)
+    {
+        ThreadPool pool{threads};
+        T result{};
+        const double t = measure([&]
+                                 { result = f(pool); });
+        if (threads == 1)
+        {
+            base = t;
+            reference = result;
+        }
+
+        std::cout << "  " << threads << " threads: " << t << " ms, " << base / t << "x"
+                  << (result == reference ? "" : " MISMATCH") << "\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t maxThreads = argc > 1 ? atol(argv[1]) : ThreadPool::defaultThreads();
+    std::mt19937 rng{1234};
+
+    const DynMatrix<double> A = randomMatrix<double>(1024, rng);
+    const DynMatrix<double> B = randomMatrix<double>(1024, rng);
+    scale<DynMatrix<double>>("double product 1024x1024", maxThreads, [&](ThreadPool &pool)
+                             { return parallelProduct(A, B, pool); });
+    const DynMatrix<double> S = randomMatrix<double>(512, rng);
+    scale<DynMatrix<double>>("double inverse 512x512", maxThreads, [&](ThreadPool &pool)
+                             { return parallelGaussJordanInverse(S, pool); });
+    scale<double>("double determinant 1024x1024", maxThreads, [&](ThreadPool &pool)
+                  { return parallelRowReductionDeterminant(A, pool); });
+
+    const DynMatrix<Fraction> F = randomMatrix<Fraction>(12, rng);
+    scale<DynMatrix<Fraction>>("Fraction inverse 12x12", maxThreads, [&](ThreadPool &pool)
+                               { return parallelGaussJordanInverse(F, pool); });
+    const DynMatrix<Fraction> G = randomMatrix<Fraction>(128, rng);
+    const DynMatrix<Fraction> H = randomMatrix<Fraction>(128, rng);
+    scale<DynMatrix<Fraction>>("Fraction product 128x128", maxThreads, [&](ThreadPool &pool)
+                               { return parallelProduct(G, H, pool); });
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <include/simd.hpp>
+
+// Times the element-wise kernels at every instruction set this CPU supports
+// against the plain loops they replace in Matrix and DynMatrix
+
+template <typename F>
+double measure(const size_t &reps, F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; ++r)
+        f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / reps;
+}
+
+/// @brief Plain loop, as the matrix operators had before
+template <SimdOp Op, typename T>
+__attribute__((noinline)) void scalarLoop(T *dst, T *src, const T &s, const size_t &n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        if constexpr (Op == SimdOp::add)
+            dst[i] += src[i];
+        else if constexpr (Op == SimdOp::scale)
+            dst[i] *= s;
+        else if constexpr (Op == SimdOp::addScaled)
+            dst[i] += s * src[i];
+        else
+        {
+            T tmp{dst[i]};
+            dst[i] = src[i];
+            src[i] = tmp;
+        }
+    }
+}
+
+template <SimdOp Op, typename T>
+void runOp(const char *name, const size_t &n, std::mt19937 &rng)
+{
+    std::vector<T> a(n), b(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = (T)(rng() % 7) - 3;
+        b[i] = (T)(rng() % 7) - 3;
+    }
+    // Scale by one, so repeated runs stay in range
+    const T s = Op == SimdOp::scale ? T{1} : T{-1};
+    const size_t reps = 50000000 / n + 1;
+
+    // Every kernel starts from the same cells and must end on the same cells
+    std::vector<T> ref = a, refB = b;
+    scalarLoop<Op>(ref.data(), refB.data(), s, n);
+
+    auto time = [&](void (*kernel)(T *, T *, const T &, const size_t &), bool &ok)
+    {
+        std::vector<T> x = a, y = b;
+        kernel(x.data(), y.data(), s, n);
+        ok = x == ref && y == refB;
+        return measure(reps, [&]
+                       { kernel(x.data(), y.data(), s, n); });
+    };
+
+    bool ok = true, allOk = true;
+    const double tScalar = time(scalarLoop<Op, T>, ok);
+    std::cout << "  " << name << " n=" << n << ": scalar " << tScalar << " ns";
+
+    const double tBase = time(simdBaseline<Op, T>, ok);
+    allOk &= ok;
+    std::cout << ", baseline " << tScalar / tBase << "x";
+#if defined(__x86_64__) || defined(__i386__)
+    if (simdLevel() >= SimdLevel::avx2)
+    {
+        const double t = time(simdAvx2<Op, T>, ok);
+        allOk &= ok;
+        std::cout << ", avx2 " << tScalar / t << "x";
+    }
+    if (simdLevel() >= SimdLevel::avx512)
+    {
+        const double t = time(simdAvx512<Op, T>, ok);
+        allOk &= ok;
+        std::cout << ", avx512f " << tScalar / t << "x";
+    }
+#endif
+    std::cout << (allOk ? "" : " MISMATCH") << "\n";
+}
+
+template <typename T>
+void run(const char *type, std::mt19937 &rng)
+{
+    std::cout << type << "\n";
+    for (size_t n : {64, 1024, 16384})
+    {
+        runOp<SimdOp::add, T>("add      ", n, rng);
+        runOp<SimdOp::scale, T>("scale    ", n, rng);
+        runOp<SimdOp::addScaled, T>("addScaled", n, rng);
+        runOp<SimdOp::swap, T>("swap     ", n, rng);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << "Detected: " << simdLevelName(simdLevel()) << "\n";
+
+    std::mt19937 rng{1234};
+    run<float>("float", rng);
+    run<double>("double", rng);
+    run<int32_t>("int32_t", rng);
+    run<int64_t>("int64_t", rng);
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+
+// Times solving A * X = B with solve() against the inverse-then-multiply path
+
+template <typename F>
+double measure(const size_t &reps, F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; ++r)
+        f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+}
+
+template <size_t R, size_t C, typename T>
+void fill(Matrix<R, C, T> &m, std::mt19937 &rng, const bool &integer)
+{
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            if constexpr (std::is_same_v<T, Fraction>)
+                m.data[i][j] = Fraction{(int64_t)(rng() % 7) - 3, integer ? 1 : (int64_t)(rng() % 3) + 1};
+            else
+                m.data[i][j] = (T)(rng() % 2001) / 1000 - 1;
+        }
+    }
+}
+
+/// @brief Largest residual |A * X - B|, zero for exact types
+template <size_t R, size_t C, typename T>
+double residual(const Matrix<R, R, T> &A, const Matrix<R, C, T> &X, const Matrix<R, C, T> &B)
+{
+    const Matrix<R, C, T> AX = A * X;
+    double worst = 0;
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            if constexpr (std::is_same_v<T, Fraction>)
+                worst = std::max(worst, AX.data[i][j] == B.data[i][j] ? 0.0 : 1.0);
+            else
+                worst = std::max(worst, (double)std::abs(AX.data[i][j] - B.data[i][j]));
+        }
+    }
+
+    return worst;
+}
+
+template <size_t R, size_t C, typename T>
+void run(const char *type, const size_t &reps, const bool &integer, std::mt19937 &rng)
+{
+    // Static, so large orders don't live on the stack
+    static Matrix<R, R, T> A;
+    static Matrix<R, C, T> B, viaInverse, viaSolve;
+    fill(A, rng, integer);
+    fill(B, rng, integer);
+
+    const double tInverse = measure(reps, [&]
+                                    { viaInverse = A.inverse() * B; });
+    const double tSolve = measure(reps, [&]
+                                  { viaSolve = solve(A, B); });
+
+    std::cout << type << (integer ? " integer " : " ") << R << "x" << R << ", " << C << " rhs: inverse * B "
+              << tInverse << " us, solve " << tSolve << " us, " << tInverse / tSolve << "x"
+              << " (residuals " << residual(A, viaInverse, B) << ", " << residual(A, viaSolve, B) << ")\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    run<8, 1, double>("double", 100000, false, rng);
+    run<32, 1, double>("double", 5000, false, rng);
+    run<32, 8, double>("double", 5000, false, rng);
+    run<128, 1, double>("double", 100, false, rng);
+    run<128, 16, double>("double", 100, false, rng);
+    run<4, 1, Fraction>("Fraction", 100000, false, rng);
+    run<4, 1, Fraction>("Fraction", 100000, true, rng);
+    run<8, 1, Fraction>("Fraction", 10000, false, rng);
+    run<8, 1, Fraction>("Fraction", 10000, true, rng);
+    run<8, 4, Fraction>("Fraction", 10000, true, rng);
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <include/bigfraction.hpp>
+#include <include/dyn_matrix.hpp>
+#include <include/sparse.hpp>
+#include <include/sparse_lu.hpp>
+
+// Sparse storage, products and LU on inputs that are mostly zeros, against the
+// same operations on DynMatrix. The LU runs on 2D grid Laplacians, whose fill
+// depends heavily on the elimination order, with natural and minimum degree orderings
+
+template <typename F>
+double measure(F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/// @brief 5-point Laplacian of a g x g grid, n = g * g
+template <typename T>
+SparseMatrix<T> gridLaplacian(const size_t &g)
+{
+    std::vector<SparseEntry<T>> entries;
+    for (size_t y = 0; y < g; ++y)
+    {
+        for (size_t x = 0; x < g; ++x)
+        {
+            const size_t i = y * g + x;
+            entries.push_back({i, i, T{4}});
+            if (x > 0)
+                entries.push_back({i, i - 1, T{-1}});
+            if (x + 1 < g)
+                entries.push_back({i, i + 1, T{-1}});
+            if (y > 0)
+                entries.push_back({i, i - g, T{-1}});
+            if (y + 1 < g)
+                entries.push_back({i, i + g, T{-1}});
+        }
+    }
+
+    return SparseMatrix<T>{g * g, g * g, entries};
+}
+
+/// @brief Random matrix with a given fraction of nonzeros
+SparseMatrix<double> randomSparse(const size_t &r, const size_t &c, const double &density, std::mt19937 &rng)
+{
+    std::vector<SparseEntry<double>> entries;
+    const size_t count = (size_t)(density * r * c);
+    for (size_t k = 0; k < count; ++k)
+        entries.push_back({rng() % r, rng() % c, (double)(rng() % 2001) / 1000 - 1});
+
+    return SparseMatrix<double>{r, c, entries};
+}
+
+double maxDifference(const DynMatrix<double> &a, const DynMatrix<double> &b)
+{
+    double worst = 0;
+    for (size_t i = 0; i < a.rows(); ++i)
+        for (size_t j = 0; j < a.cols(); ++j)
+            worst = std::max(worst, std::abs(a[i][j] - b[i][j]));
+
+    return worst;
+}
+
+void products(const size_t &n, const double &density, std::mt19937 &rng)
+{
+    const SparseMatrix<double> a = randomSparse(n, n, density, rng), b = randomSparse(n, n, density, rng);
+    const DynMatrix<double> da = a.toDense(), db = b.toDense();
+
+    DynMatrix<double> dense, mixed;
+    SparseMatrix<double> sparse;
+    const double tDense = measure([&]
+                                  { dense = da * db; });
+    const double tMixed = measure([&]
+                                  { mixed = a * db; });
+    const double tSparse = measure([&]
+                                   { sparse = a * b; });
+
+    std::cout << "Products, " << n << "x" << n << ", " << a.nonZeros() << " nonzeros ("
+              << 100.0 * a.nonZeros() / (n * n) << "%)\n"
+              << "  storage: dense " << n * n * sizeof(double) / 1024 << " KiB, sparse "
+              << (a.nonZeros() * (sizeof(double) + sizeof(size_t)) + (n + 1) * sizeof(size_t)) / 1024 << " KiB\n"
+              << "  dense * dense " << tDense << " ms, sparse * dense " << tMixed << " ms (max diff "
+              << maxDifference(dense, mixed) << "), sparse * sparse " << tSparse << " ms, "
+              << sparse.nonZeros() << " nonzeros (max diff " << maxDifference(dense, sparse.toDense()) << ")\n";
+}
+
+void factorization(const size_t &g)
+{
+    const size_t n = g * g;
+    const SparseMatrix<double> a = gridLaplacian<double>(g);
+    std::vector<double> b(n);
+    for (size_t i = 0; i < n; ++i)
+        b[i] = (double)(i % 7) - 3;
+
+    std::cout << "LU of " << g << "x" << g << " grid Laplacian, order " << n << ", " << a.nonZeros() << " nonzeros\n";
+
+    std::vector<size_t> natural(n);
+    std::iota(natural.begin(), natural.end(), 0);
+    std::vector<size_t> order;
+    const double tOrder = measure([&]
+                                  { order = minimumDegreeOrdering(a); });
+
+    for (const bool &reordered : {false, true})
+    {
+        std::unique_ptr<SparseLU<double>> lu;
+        const double tFactor = measure([&]
+                                       { lu = std::make_unique<SparseLU<double>>(a, reordered ? order : natural); });
+        std::vector<double> x;
+        const double tSolve = measure([&]
+                                      { x = lu->solve(b); });
+
+        const std::vector<double> ax = a * x;
+        double residual = 0;
+        for (size_t i = 0; i < n; ++i)
+            residual = std::max(residual, std::abs(ax[i] - b[i]));
+
+        std::cout << "  " << (reordered ? "minimum degree" : "natural") << ": factors " << lu->nonZeros()
+                  << " nonzeros, ordering " << (reordered ? tOrder : 0) << " ms, factor " << tFactor
+                  << " ms, solve " << tSolve << " ms, residual " << residual << "\n";
+    }
+
+    if (n <= 2500)
+    {
+        const DynMatrix<double> d = a.toDense();
+        DynMatrix<double> inv;
+        const double tDense = measure([&]
+                                      { inv = d.inverse(); });
+        std::cout << "  dense inverse " << tDense << " ms\n";
+    }
+}
+
+void exact(const size_t &g)
+{
+    const SparseMatrix<BigFraction> a = gridLaplacian<BigFraction>(g);
+    const DynMatrix<BigFraction> d = a.toDense();
+
+    BigFraction sparseDet, denseDet;
+    const double tSparse = measure([&]
+                                   { sparseDet = SparseLU<BigFraction>{a}.determinant(); });
+    const double tDense = measure([&]
+                                  { denseDet = d.determinant(); });
+
+    std::cout << "BigFraction determinant of " << g << "x" << g << " grid Laplacian: sparse LU " << tSparse
+              << " ms, dense " << tDense << " ms, " << (sparseDet == denseDet ? "equal" : "DIFFERENT") << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    products(1000, 0.01, rng);
+    products(2000, 0.005, rng);
+    factorization(40);
+    factorization(200);
+    exact(10);
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <include/bigfraction.hpp>
+#include <include/dyn_matrix.hpp>
+#include <include/fraction.hpp>
+#include <include/strassen.hpp>
+
+// Strassen-Winograd product against the naive triple loop and the ordinary
+// operator*, reporting scalar multiplications and wall time per cell type,
+// then sweeping the crossover order to tune strassenCrossover
+
+template <typename F>
+double measure(F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename T>
+DynMatrix<T> randomMatrix(const size_t &o, std::mt19937 &rng)
+{
+    DynMatrix<T> m{o, o};
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            if constexpr (std::is_arithmetic_v<T>)
+                m[i][j] = (T)(rng() % 2001) / 1000 - 1;
+            else
+                m[i][j] = T{Fraction{(int64_t)(rng() % 5) - 2, (int64_t)(rng() % 2) + 1}};
+        }
+    }
+
+    return m;
+}
+
+/// @brief Naive triple loop, one multiplication per term
+template <typename T>
+DynMatrix<T> naiveProduct(const DynMatrix<T> &m0, const DynMatrix<T> &m1)
+{
+    DynMatrix<T> res{m0.rows(), m1.cols()};
+    for (size_t i = 0; i < m0.rows(); ++i)
+    {
+        for (size_t k = 0; k < m0.cols(); ++k)
+        {
+            for (size_t j = 0; j < m1.cols(); ++j)
+                res[i][j] += m0[i][k] * m1[k][j];
+        }
+    }
+
+    return res;
+}
+
+/// @brief Largest difference between two products, zero for exact types
+template <typename T>
+double difference(const DynMatrix<T> &a, const DynMatrix<T> &b)
+{
+    double worst = 0;
+    for (size_t i = 0; i < a.rows(); ++i)
+    {
+        for (size_t j = 0; j < a.cols(); ++j)
+        {
+            if constexpr (std::is_arithmetic_v<T>)
+                worst = std::max(worst, (double)std::abs(a[i][j] - b[i][j]));
+            else
+                worst = std::max(worst, a[i][j] == b[i][j] ? 0.0 : 1.0);
+        }
+    }
+
+    return worst;
+}
+
+template <typename T>
+void run(const char *type, const std::vector<size_t> &orders, const size_t &naiveLimit,
+         const std::vector<size_t> &crossovers, std::mt19937 &rng)
+{
+    std::cout << type << ", crossover " << strassenCrossover<T> << "\n";
+    for (const size_t &o : orders)
+    {
+        const DynMatrix<T> a = randomMatrix<T>(o, rng), b = randomMatrix<T>(o, rng);
+
+        DynMatrix<T> ref, res;
+        const double tOrdinary = measure([&]
+                                         { ref = a * b; });
+        const double tStrassen = measure([&]
+                                         { res = strassenProduct(a, b); });
+
+        std::cout << "  " << o << "x" << o << ": ";
+        if (o <= naiveLimit)
+        {
+            DynMatrix<T> naive;
+            const double tNaive = measure([&]
+                                          { naive = naiveProduct(a, b); });
+            std::cout << "naive " << tNaive << " ms, ";
+        }
+        std::cout << "operator* " << tOrdinary << " ms, strassen " << tStrassen << " ms ("
+                  << tOrdinary / tStrassen << "x); multiplications " << (uint64_t)o * o * o << " -> "
+                  << strassenMultiplications(o, o, o, strassenCrossover<T>) << ", max diff " << difference(ref, res) << "\n";
+    }
+
+    // Crossover sweep on the largest order
+    const size_t o = orders.back();
+    const DynMatrix<T> a = randomMatrix<T>(o, rng), b = randomMatrix<T>(o, rng);
+    std::cout << "  crossover sweep at " << o << "x" << o << ":";
+    for (const size_t &c : crossovers)
+    {
+        DynMatrix<T> res;
+        const double t = measure([&]
+                                 { res = strassenProduct(a, b, c); });
+        std::cout << " " << c << ": " << t << " ms;";
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    run<double>("double", {256, 512, 1024, 2048}, 512, {128, 256, 512, 1024}, rng);
+    run<Fraction>("Fraction", {64, 128, 256, 512}, 256, {16, 32, 48, 64, 128}, rng);
+    run<BigFraction>("BigFraction", {32, 64, 128}, 128, {8, 16, 32, 64}, rng);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <include/lu.hpp>
+#include <include/matrix.hpp>
+#include <include/structured.hpp>
+
+// Structured matrices against the same matrices stored dense: storage, and
+// microseconds per determinant, inverse, solve and product with a dense matrix.
+// Dense determinants and solves go through LU, dense inverses through inverse()
+
+template <typename F>
+double measure(const size_t &reps, F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; ++r)
+        f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+}
+
+template <size_t N, typename T>
+Matrix<N, N, T> randomMatrix(std::mt19937 &rng)
+{
+    // Diagonally dominant, so every structure taken from it is well conditioned
+    Matrix<N, N, T> m{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                m.data[i][j] = (T)(rng() % 2001) / 1000 - 1;
+            else
+                m.data[i][j] = T{(int64_t)(rng() % 5) - 2};
+        }
+        m.data[i][i] = m.data[i][i] + T{(int64_t)N};
+    }
+
+    return m;
+}
+
+/// @brief Makes the compiler assume a matrix may have changed, so calls on it are not hoisted out of the timing loop
+template <typename M>
+void clobber(const M &m)
+{
+    asm volatile("" : : "r"(&m) : "memory");
+}
+
+/// @brief First cell of a structured or dense matrix
+template <typename M>
+auto firstCell(const M &m)
+{
+    return m(0, 0);
+}
+
+template <size_t R, size_t C, typename T>
+T firstCell(const Matrix<R, C, T> &m)
+{
+    return m.data[0][0];
+}
+
+template <size_t N, typename T, typename S>
+void run(const char *name, const S &s, const size_t &reps, std::mt19937 &rng)
+{
+    Matrix<N, N, T> d = s.toMatrix();
+    const Matrix<N, N, T> r = randomMatrix<N, T>(rng);
+    Matrix<N, 4, T> b{};
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            b.data[i][j] = r.data[i][j];
+
+    // Results are summed into a sink so no call is optimized away
+    size_t sink = 0;
+    const double detDense = measure(reps, [&]
+                                    { clobber(d); clobber(s); sink += LU<N, T>{d}.determinant() != T{0}; });
+    const double detStruct = measure(reps, [&]
+                                     { clobber(d); clobber(s); sink += s.determinant() != T{0}; });
+    const double invDense = measure(reps, [&]
+                                    { clobber(d); clobber(s); sink += d.inverse().data[0][0] != T{0}; });
+    const double invStruct = measure(reps, [&]
+                                     { clobber(d); clobber(s); sink += firstCell(s.inverse()) != T{0}; });
+    const double solveDense = measure(reps, [&]
+                                      { clobber(d); clobber(s); sink += LU<N, T>{d}.solve(b).data[0][0] != T{0}; });
+    const double solveStruct = measure(reps, [&]
+                                       { clobber(d); clobber(s); sink += s.solve(b).data[0][0] != T{0}; });
+    const double prodDense = measure(reps, [&]
+                                     { clobber(d); clobber(s); sink += (d * b).data[0][0] != T{0}; });
+    const double prodStruct = measure(reps, [&]
+                                      { clobber(d); clobber(s); sink += (s * b).data[0][0] != T{0}; });
+
+    std::cout << "  " << name << ": " << sizeof(d) << " -> " << sizeof(s) << " bytes; determinant "
+              << detDense << " -> " << detStruct << ", inverse " << invDense << " -> " << invStruct
+              << ", solve " << solveDense << " -> " << solveStruct << ", product " << prodDense
+              << " -> " << prodStruct << (sink == 0 ? " " : "") << "\n";
+}
+
+template <size_t N, typename T>
+void runAll(const char *type, const size_t &reps, std::mt19937 &rng)
+{
+    const Matrix<N, N, T> m = randomMatrix<N, T>(rng);
+    std::cout << type << " " << N << "x" << N << ", dense -> structured (us per call)\n";
+    run<N, T>("diagonal", DiagonalMatrix<N, T>{m}, reps, rng);
+    run<N, T>("upper triangular", UpperTriangularMatrix<N, T>{m}, reps, rng);
+    run<N, T>("lower triangular", LowerTriangularMatrix<N, T>{m}, reps, rng);
+    run<N, T>("symmetric", SymmetricMatrix<N, T>{m}, reps, rng);
+    run<N, T>("band, K = 2", BandMatrix<N, 2, T>{m}, reps, rng);
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    runAll<64, double>("double", 200, rng);
+    runAll<8, Fraction>("Fraction", 2000, rng);
+
+    return 0;
+}
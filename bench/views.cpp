@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <include/dyn_matrix.hpp>
+#include <include/matrix.hpp>
+#include <include/matrix_view.hpp>
+
+// Minors and blocks through views against copies: the Laplace determinant, which
+// used to build every minor as a new Matrix, and products of small tiles of a
+// large DynMatrix, copied into their own matrices or read in place
+
+template <typename F>
+double measure(F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/// @brief Laplace determinant as it was before views, copying each minor into a new Matrix
+template <size_t R, typename T>
+T copyingLapLace(const Matrix<R, R, T> &m)
+{
+    if constexpr (R == 1)
+    {
+        return m.data[0][0];
+    }
+    else
+    {
+        T det = T{0};
+        for (size_t i = 0; i < R; ++i)
+        {
+            if (m.data[0][i] == T{0})
+                continue;
+
+            Matrix<R - 1, R - 1, T> n{};
+            for (size_t j = 0; j < R - 1; ++j)
+            {
+                for (size_t k = 0; k < R - 1; ++k)
+                {
+                    size_t col = k < i ? k : k + 1;
+                    n.data[j][k] = m.data[j + 1][col];
+                }
+            }
+
+            det += (i & 1 ? -m.data[0][i] : m.data[0][i]) * copyingLapLace(n);
+        }
+
+        return det;
+    }
+}
+
+template <size_t R>
+void laplace(std::mt19937 &rng)
+{
+    Matrix<R, R, double> m{};
+    for (size_t i = 0; i < R; ++i)
+        for (size_t j = 0; j < R; ++j)
+            m.data[i][j] = (double)(rng() % 2001) / 1000 - 1;
+
+    double before = 0, after = 0;
+    const double tBefore = measure([&]
+                                   { before = copyingLapLace(m); });
+    const double tAfter = measure([&]
+                                  { after = lapLaceDeterminant(m); });
+
+    std::cout << "  " << R << "x" << R << ": copies " << tBefore << " ms, views " << tAfter << " ms ("
+              << tBefore / tAfter << "x), diff " << std::abs(before - after) << "\n";
+}
+
+template <size_t B>
+void tiles(const size_t &n, std::mt19937 &rng)
+{
+    DynMatrix<double> a{n, n};
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            a[i][j] = (double)(rng() % 2001) / 1000 - 1;
+
+    // Each diagonal tile times the tile to its right, summed into one B x B result
+    Matrix<B, B, double> copied{}, viewed{}, product{};
+    const double tCopy = measure([&]
+                                 {
+                                     for (size_t t = 0; t + 2 * B <= n; t += B)
+                                     {
+                                         Matrix<B, B, double> x{}, y{};
+                                         for (size_t i = 0; i < B; ++i)
+                                             for (size_t j = 0; j < B; ++j)
+                                             {
+                                                 x.data[i][j] = a[t + i][t + j];
+                                                 y.data[i][j] = a[t + i][t + B + j];
+                                             }
+                                         copied += x * y;
+                                     } });
+    const double tView = measure([&]
+                                 {
+                                     for (size_t t = 0; t + 2 * B <= n; t += B)
+                                     {
+                                         viewMultiply(a.view().block(t, t, B, B), a.view().block(t, t + B, B, B), product.span());
+                                         viewed += product;
+                                     } });
+
+    double diff = 0;
+    for (size_t i = 0; i < B; ++i)
+        for (size_t j = 0; j < B; ++j)
+            diff = std::max(diff, std::abs(copied.data[i][j] - viewed.data[i][j]));
+
+    std::cout << "  " << B << "x" << B << " tiles of " << n << "x" << n << ": copies " << tCopy << " ms, views "
+              << tView << " ms, diff " << diff << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::mt19937 rng{1234};
+    std::cout << "Laplace determinant\n";
+    laplace<8>(rng);
+    laplace<9>(rng);
+    laplace<10>(rng);
+
+    std::cout << "Tile products\n";
+    tiles<4>(1 << 14, rng);
+    tiles<8>(1 << 13, rng);
+
+    return 0;
+}
@@ -0,0 +1,429 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <include/cofactor.hpp>
+#include <include/dyn_matrix.hpp>
+#include <include/matrix.hpp>
+#include <include/simd.hpp>
+#include <include/thread_pool.hpp>
+
+// Batched products, determinants and inverses of many small square matrices.
+//
+// A MatrixBatch stores its matrices as a structure of arrays: every cell (i, j)
+// is one contiguous run holding that cell of every matrix. Loading a vector from
+// the run of a cell loads that cell of several consecutive matrices, so each
+// lane of a register works on a different matrix and the closed-form formulas
+// run on whole registers, with no shuffles and no lane left idle. As in
+// simd.hpp, the kernels are compiled for 16, 32 and 64-byte vectors and the
+// widest one the CPU supports is picked at run time
+
+/// @brief Whether a cell type has batched kernels
+template <typename T>
+constexpr bool hasBatch = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/// @brief Fewest matrices per parallel chunk
+constexpr size_t batchGrain = 1 << 12;
+
+/// @brief Batch of square matrices of the same order, stored cell-major
+/// @tparam N Matrix order
+/// @tparam T Matrix data type
+template <size_t N, typename T>
+class MatrixBatch
+{
+public:
+    /// @brief Empty constructor, batch of no matrices
+    MatrixBatch();
+
+    /// @brief Constructor with number of matrices, all null
+    /// @param count Number of matrices
+    explicit MatrixBatch(const size_t &count);
+
+    /// @brief Constructor from separate matrices
+    /// @param ms Matrices to be copied
+    MatrixBatch(const std::vector<Matrix<N, N, T>> &ms);
+
+    /// @brief Number of matrices
+    size_t size() const;
+
+    /// @brief Distance in cells between the runs of two consecutive cells. Runs are padded
+    /// so that each one starts on a cache line
+    size_t stride() const;
+
+    /// @brief Run of one cell across the batch
+    /// @param i Row
+    /// @param j Column
+    /// @return Pointer to cell (i, j) of the first matrix; matrix k's is k cells further
+    T *cell(const size_t &i, const size_t &j);
+
+    /// @brief Run of one cell across the batch
+    /// @param i Row
+    /// @param j Column
+    /// @return Pointer to cell (i, j) of the first matrix; matrix k's is k cells further
+    const T *cell(const size_t &i, const size_t &j) const;
+
+    /// @brief Gathers one matrix of the batch
+    /// @param k Matrix index
+    /// @return Copy of matrix k
+    Matrix<N, N, T> get(const size_t &k) const;
+
+    /// @brief Scatters a matrix into the batch
+    /// @param k Matrix index
+    /// @param m Matrix to be copied
+    void set(const size_t &k, const Matrix<N, N, T> &m);
+
+private:
+    /// @brief Number of matrices
+    size_t count = 0;
+
+    /// @brief Cell (i, j) of every matrix is row i * N + j
+    DynMatrix<T> cells;
+
+    /// @brief Row length giving runs an odd number of cache lines apart. Runs a power of two
+    /// apart would all map to the same cache sets, and the N * N streams of a kernel would
+    /// keep evicting each other
+    /// @param count Number of matrices
+    /// @return Cells per run
+    static size_t runLength(const size_t &count);
+};
+
+template <size_t N, typename T>
+MatrixBatch<N, T>::MatrixBatch() {}
+
+template <size_t N, typename T>
+MatrixBatch<N, T>::MatrixBatch(const size_t &count) : count{count}, cells{N * N, runLength(count)} {}
+
+template <size_t N, typename T>
+MatrixBatch<N, T>::MatrixBatch(const std::vector<Matrix<N, N, T>> &ms) : MatrixBatch(ms.size())
+{
+    for (size_t k = 0; k < ms.size(); ++k)
+        set(k, ms[k]);
+}
+
+template <size_t N, typename T>
+size_t MatrixBatch<N, T>::size() const
+{
+    return count;
+}
+
+template <size_t N, typename T>
+size_t MatrixBatch<N, T>::stride() const
+{
+    return cells.stride();
+}
+
+template <size_t N, typename T>
+size_t MatrixBatch<N, T>::runLength(const size_t &count)
+{
+    constexpr size_t line = dynMatrixAlignment / sizeof(T);
+    const size_t lines = (count + line - 1) / line;
+
+    return (lines % 2 == 0 && lines > 0 ? lines + 1 : lines) * line;
+}
+
+template <size_t N, typename T>
+T *MatrixBatch<N, T>::cell(const size_t &i, const size_t &j)
+{
+    return cells[i * N + j];
+}
+
+template <size_t N, typename T>
+const T *MatrixBatch<N, T>::cell(const size_t &i, const size_t &j) const
+{
+    return cells[i * N + j];
+}
+
+template <size_t N, typename T>
+Matrix<N, N, T> MatrixBatch<N, T>::get(const size_t &k) const
+{
+    assert((k < size()) && "Matrix index out of the batch");
+
+    Matrix<N, N, T> m{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            m.data[i][j] = cell(i, j)[k];
+        }
+    }
+
+    return m;
+}
+
+template <size_t N, typename T>
+void MatrixBatch<N, T>::set(const size_t &k, const Matrix<N, N, T> &m)
+{
+    assert((k < size()) && "Matrix index out of the batch");
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            cell(i, j)[k] = m.data[i][j];
+        }
+    }
+}
+
+/// @brief Operations implemented by the batched kernels
+enum class BatchOp
+{
+    multiply,    // out = a * b
+    determinant, // out[k] = det(a)
+    inverse      // out = inverse(a), null where a is singular
+};
+
+/// @brief Runs an operation on the matrices of [k0, k1), V-sized vectors of them at once.
+/// V is a vector type, or T itself for the tail
+/// @param a Cells of the left or only operand, cell (i, j) at a + (i * N + j) * stride
+/// @param b Cells of the right operand, multiply only
+/// @param out Result cells, laid out like a; determinant writes one run of size() cells
+/// @param stride Distance between cell runs
+/// @param k0 First matrix
+/// @param k1 One past the last matrix, k1 - k0 is a whole number of vectors
+/// @return Number of singular matrices, for inverse
+template <typename V, BatchOp Op, size_t N, typename T>
+__attribute__((always_inline)) inline size_t batchSteps(const T *a, const T *b, T *out, const size_t &stride,
+                                                        const size_t &k0, const size_t &k1)
+{
+    constexpr size_t lanes = sizeof(V) / sizeof(T);
+
+    // Local copy, so stores to out can't alias it and force reloads
+    const size_t s = stride;
+
+    size_t singular = 0;
+    for (size_t k = k0; k < k1; k += lanes)
+    {
+        V x[N][N];
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < N; ++j)
+                memcpy(&x[i][j], a + (i * N + j) * s + k, sizeof(V));
+        }
+
+        V res[N][N];
+        if constexpr (Op == BatchOp::multiply)
+        {
+            V y[N][N];
+            for (size_t i = 0; i < N; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    memcpy(&y[i][j], b + (i * N + j) * s + k, sizeof(V));
+            }
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                {
+                    V sum = x[i][0] * y[0][j];
+                    for (size_t l = 1; l < N; ++l)
+                        sum += x[i][l] * y[l][j];
+                    res[i][j] = sum;
+                }
+            }
+        }
+        else if constexpr (Op == BatchOp::determinant)
+        {
+            V det;
+            cofactorDeterminant<N>(x, det);
+            memcpy(out + k, &det, sizeof(V));
+            continue;
+        }
+        else
+        {
+            V det;
+            cofactorAdjugate<N>(x, res, det);
+
+            // Singular lanes get a null inverse, as Matrix::inverse returns
+            const V zero = det - det;
+            const V invDet = det != zero ? T{1} / det : zero;
+            for (size_t i = 0; i < N; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    res[i][j] *= invDet;
+            }
+
+            if constexpr (lanes == 1)
+                singular += det == zero;
+            else
+            {
+                for (size_t l = 0; l < lanes; ++l)
+                    singular += det[l] == T{0};
+            }
+        }
+
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < N; ++j)
+                memcpy(out + (i * N + j) * s + k, &res[i][j], sizeof(V));
+        }
+    }
+
+    return singular;
+}
+
+/// @brief Runs an operation on [k0, k1) with W-byte vectors, the tail one matrix at a time.
+/// Always inlined, so it compiles for the instruction set of the function it is called from
+template <size_t W, BatchOp Op, size_t N, typename T>
+__attribute__((always_inline)) inline size_t batchLoop(const T *a, const T *b, T *out, const size_t &stride,
+                                                       const size_t &k0, const size_t &k1)
+{
+    typedef T Vec __attribute__((vector_size(W)));
+    constexpr size_t lanes = W / sizeof(T);
+
+    const size_t mid = k0 + (k1 - k0) / lanes * lanes;
+    return batchSteps<Vec, Op, N>(a, b, out, stride, k0, mid) +
+           batchSteps<T, Op, N>(a, b, out, stride, mid, k1);
+}
+
+/// @brief Kernel for the baseline instruction set
+template <BatchOp Op, size_t N, typename T>
+size_t batchBaseline(const T *a, const T *b, T *out, const size_t &stride, const size_t &k0, const size_t &k1)
+{
+    return batchLoop<16, Op, N>(a, b, out, stride, k0, k1);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/// @brief Kernel for AVX2 hosts
+template <BatchOp Op, size_t N, typename T>
+__attribute__((target("avx2"))) size_t batchAvx2(const T *a, const T *b, T *out, const size_t &stride,
+                                                 const size_t &k0, const size_t &k1)
+{
+    return batchLoop<32, Op, N>(a, b, out, stride, k0, k1);
+}
+
+/// @brief Kernel for AVX-512 hosts
+template <BatchOp Op, size_t N, typename T>
+__attribute__((target("avx512f"))) size_t batchAvx512(const T *a, const T *b, T *out, const size_t &stride,
+                                                      const size_t &k0, const size_t &k1)
+{
+    return batchLoop<64, Op, N>(a, b, out, stride, k0, k1);
+}
+#endif
+
+/// @brief Runs an operation over a whole batch, split in chunks run in parallel, each with the
+/// widest kernel the CPU supports
+/// @param count Number of matrices
+/// @return Number of singular matrices, for inverse
+template <BatchOp Op, size_t N, typename T>
+size_t batchApply(const T *a, const T *b, T *out, const size_t &stride, const size_t &count, ThreadPool &pool)
+{
+    static_assert(hasBatch<T>, "No batched kernels for this type");
+
+    auto kernel = batchBaseline<Op, N, T>;
+#if defined(__x86_64__) || defined(__i386__)
+    switch (simdLevel())
+    {
+    case SimdLevel::avx512:
+        kernel = batchAvx512<Op, N, T>;
+        break;
+    case SimdLevel::avx2:
+        kernel = batchAvx2<Op, N, T>;
+        break;
+    default:
+        break;
+    }
+#endif
+
+    // Chunks are made of whole cache lines of every run, so no two threads write the same line
+    constexpr size_t line = dynMatrixAlignment / sizeof(T);
+    const size_t lines = (count + line - 1) / line;
+
+    std::atomic<size_t> singular{0};
+    pool.parallelFor(0, lines, batchGrain / line, [&](const size_t &l0, const size_t &l1)
+                     {
+        const size_t k1 = l1 * line < count ? l1 * line : count;
+        singular.fetch_add(kernel(a, b, out, stride, l0 * line, k1), std::memory_order_relaxed); });
+
+    return singular.load(std::memory_order_relaxed);
+}
+
+/// @brief Products of matching pairs of matrices, res[k] = m0[k] * m1[k], into an existing batch.
+/// Reusing res across calls skips allocating and clearing a new batch each time
+/// @param m0 Left matrices
+/// @param m1 Right matrices
+/// @param res Batch of products, resized if needed; may be m0 or m1
+/// @param pool Thread pool
+template <size_t N, typename T>
+void batchMultiply(const MatrixBatch<N, T> &m0, const MatrixBatch<N, T> &m1, MatrixBatch<N, T> &res,
+                   ThreadPool &pool = ThreadPool::shared())
+{
+    assert((m0.size() == m1.size()) && "Batches must hold the same number of matrices");
+
+    if (res.size() != m0.size())
+        res = MatrixBatch<N, T>{m0.size()};
+    if (res.size() > 0)
+        batchApply<BatchOp::multiply, N>(m0.cell(0, 0), m1.cell(0, 0), res.cell(0, 0), res.stride(), res.size(), pool);
+}
+
+/// @brief Products of matching pairs of matrices, res[k] = m0[k] * m1[k]
+/// @param m0 Left matrices
+/// @param m1 Right matrices
+/// @param pool Thread pool
+/// @return Batch of products
+template <size_t N, typename T>
+MatrixBatch<N, T> batchMultiply(const MatrixBatch<N, T> &m0, const MatrixBatch<N, T> &m1,
+                                ThreadPool &pool = ThreadPool::shared())
+{
+    MatrixBatch<N, T> res{m0.size()};
+    batchMultiply(m0, m1, res, pool);
+    return res;
+}
+
+/// @brief Determinant of every matrix of a batch, into an existing vector
+/// @param m Matrices
+/// @param res Determinant of matrix k at index k, resized if needed
+/// @param pool Thread pool
+template <size_t N, typename T>
+void batchDeterminant(const MatrixBatch<N, T> &m, std::vector<T> &res, ThreadPool &pool = ThreadPool::shared())
+{
+    res.resize(m.size());
+    if (m.size() > 0)
+        batchApply<BatchOp::determinant, N>(m.cell(0, 0), m.cell(0, 0), res.data(), m.stride(), m.size(), pool);
+}
+
+/// @brief Determinant of every matrix of a batch
+/// @param m Matrices
+/// @param pool Thread pool
+/// @return Determinant of matrix k at index k
+template <size_t N, typename T>
+std::vector<T> batchDeterminant(const MatrixBatch<N, T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    std::vector<T> res(m.size());
+    batchDeterminant(m, res, pool);
+    return res;
+}
+
+/// @brief Inverse of every matrix of a batch by the closed-form adjugate formula, into an existing batch
+/// @param m Matrices
+/// @param res Batch of inverses, resized if needed, with a null matrix in place of every
+/// singular one; may be m itself
+/// @param pool Thread pool
+template <size_t N, typename T>
+void batchInverse(const MatrixBatch<N, T> &m, MatrixBatch<N, T> &res, ThreadPool &pool = ThreadPool::shared())
+{
+    if (res.size() != m.size())
+        res = MatrixBatch<N, T>{m.size()};
+    if (res.size() == 0)
+        return;
+
+    const size_t singular = batchApply<BatchOp::inverse, N>(m.cell(0, 0), m.cell(0, 0), res.cell(0, 0), res.stride(), res.size(), pool);
+    if (singular > 0)
+        printf("No inverse: %ld of %ld matrices are singular\n\n", singular, res.size());
+}
+
+/// @brief Inverse of every matrix of a batch, by the closed-form adjugate formula
+/// @param m Matrices
+/// @param pool Thread pool
+/// @return Batch of inverses, with a null matrix in place of every singular one
+template <size_t N, typename T>
+MatrixBatch<N, T> batchInverse(const MatrixBatch<N, T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    MatrixBatch<N, T> res{m.size()};
+    batchInverse(m, res, pool);
+    return res;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <ostream>
+
+#include <include/bigint.hpp>
+#include <include/fraction.hpp>
+
+/// @brief Fraction with arbitrary-precision numerator and denominator, never overflows
+class BigFraction
+{
+public:
+    /// @brief Fraction numerator
+    BigInt numerator;
+
+    /// @brief Fraction denominator, always positive
+    BigInt denominator;
+
+    /// @brief Empty constructor
+    BigFraction();
+
+    /// @brief Constructor with only numerator
+    BigFraction(const int64_t &numerator);
+
+    /// @brief Constructor with only numerator
+    BigFraction(const BigInt &numerator);
+
+    /// @brief Constructor with both numerator and denominator
+    BigFraction(const BigInt &numerator, const BigInt &denominator);
+
+    /// @brief Constructor from 64-bit fraction
+    /// @param f Fraction to be converted
+    BigFraction(const Fraction &f);
+
+    /// @brief Get inverse of fraction (raised to -1)
+    /// @return Inverse of fraction
+    BigFraction inverse() const;
+
+    /// @brief Evaluate fraction, that is, divide numerator by denominator
+    /// @return Result of evaluated fraction
+    double eval() const;
+
+    /// @brief Reduces fraction so that numerator and denominator don't have any common divisor
+    void reduce();
+
+    /// @brief Equal check operator
+    /// @param f Fraction to check
+    /// @return Whether 2 fractions are the same
+    bool operator==(const BigFraction &f) const;
+
+    /// @brief Different check operator
+    /// @param f Fraction to check
+    /// @return Whether 2 fractions are different
+    bool operator!=(const BigFraction &f) const;
+
+    /// @brief Add fraction
+    /// @param f Second fraction
+    /// @return Result of addition
+    BigFraction operator+(const BigFraction &f) const;
+
+    /// @brief Add fraction and assign
+    /// @param f Second fraction
+    /// @return Result of addition
+    BigFraction &operator+=(const BigFraction &f);
+
+    /// @brief Subtract fraction
+    /// @param f Second Fraction
+    /// @return Result of subtraction
+    BigFraction operator-(const BigFraction &f) const;
+
+    /// @brief Subtract fraction and assign
+    /// @param f Second Fraction
+    /// @return Result of subtraction
+    BigFraction &operator-=(const BigFraction &f);
+
+    /// @brief Negative fraction operator
+    /// @return Fraction with sign flipped
+    BigFraction operator-() const;
+
+    /// @brief Multiply fraction
+    /// @param f Second Fraction
+    /// @return Result of multiplication
+    BigFraction operator*(const BigFraction &f) const;
+
+    /// @brief Multiply fraction and assign
+    /// @param f Second Fraction
+    /// @return Result of multiplication
+    BigFraction &operator*=(const BigFraction &f);
+
+    /// @brief Divide fraction
+    /// @param f Second Fraction
+    /// @return Result of division
+    BigFraction operator/(const BigFraction &f) const;
+
+    /// @brief Divide fraction and assign
+    /// @param f Second Fraction
+    /// @return Result of division
+    BigFraction &operator/=(const BigFraction &f);
+
+    /// @brief Print fraction
+    /// @param os ostream
+    /// @param f Fraction
+    /// @return Given stream with fraction
+    friend std::ostream &operator<<(std::ostream &os, const BigFraction &f);
+};
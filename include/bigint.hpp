@@ -0,0 +1,183 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// @brief Arbitrary-precision signed integer. Values fitting in 64 bits are stored
+/// inline, and only larger ones use heap-allocated 32-bit limbs
+class BigInt
+{
+public:
+    /// @brief Empty constructor, holds zero
+    BigInt();
+
+    /// @brief Constructor from 64-bit integer
+    /// @param v Integer value
+    BigInt(const int64_t &v);
+
+    /// @brief Whether value is stored inline (fits in 64 bits)
+    /// @return True if no limbs are allocated
+    bool isSmall() const { return limbs.empty(); }
+
+    /// @brief Sign of value
+    /// @return -1, 0 or 1
+    int sign() const;
+
+    /// @brief Value as 64-bit integer, only valid when isSmall()
+    /// @return Inline value
+    int64_t toInt64() const;
+
+    /// @brief Approximate value as floating point
+    /// @return Converted value
+    double toDouble() const;
+
+    /// @brief Decimal representation
+    /// @return Value written in base 10
+    std::string toString() const;
+
+    /// @brief Number of bits of the absolute value
+    /// @return Position of highest set bit plus one, zero for zero
+    size_t bitLength() const;
+
+    /// @brief Absolute value
+    /// @return Value without sign
+    BigInt abs() const;
+
+    /// @brief Equal check operator
+    /// @param b Integer to check
+    /// @return Whether 2 integers are the same
+    bool operator==(const BigInt &b) const;
+
+    /// @brief Different check operator
+    /// @param b Integer to check
+    /// @return Whether 2 integers are different
+    bool operator!=(const BigInt &b) const;
+
+    /// @brief Less than operator
+    /// @param b Integer to compare
+    /// @return Whether this integer is smaller
+    bool operator<(const BigInt &b) const;
+
+    /// @brief Less or equal operator
+    /// @param b Integer to compare
+    /// @return Whether this integer is smaller or equal
+    bool operator<=(const BigInt &b) const;
+
+    /// @brief Greater than operator
+    /// @param b Integer to compare
+    /// @return Whether this integer is greater
+    bool operator>(const BigInt &b) const;
+
+    /// @brief Greater or equal operator
+    /// @param b Integer to compare
+    /// @return Whether this integer is greater or equal
+    bool operator>=(const BigInt &b) const;
+
+    /// @brief Add integer
+    /// @param b Second integer
+    /// @return Result of addition
+    BigInt operator+(const BigInt &b) const;
+
+    /// @brief Add integer and assign
+    /// @param b Second integer
+    /// @return Result of addition
+    BigInt &operator+=(const BigInt &b);
+
+    /// @brief Subtract integer
+    /// @param b Second integer
+    /// @return Result of subtraction
+    BigInt operator-(const BigInt &b) const;
+
+    /// @brief Subtract integer and assign
+    /// @param b Second integer
+    /// @return Result of subtraction
+    BigInt &operator-=(const BigInt &b);
+
+    /// @brief Negative operator
+    /// @return Integer with sign flipped
+    BigInt operator-() const;
+
+    /// @brief Multiply integer
+    /// @param b Second integer
+    /// @return Result of multiplication
+    BigInt operator*(const BigInt &b) const;
+
+    /// @brief Multiply integer and assign
+    /// @param b Second integer
+    /// @return Result of multiplication
+    BigInt &operator*=(const BigInt &b);
+
+    /// @brief Divide integer, truncating toward zero
+    /// @param b Second integer
+    /// @return Quotient
+    BigInt operator/(const BigInt &b) const;
+
+    /// @brief Divide integer and assign, truncating toward zero
+    /// @param b Second integer
+    /// @return Quotient
+    BigInt &operator/=(const BigInt &b);
+
+    /// @brief Remainder of division, with the sign of the dividend
+    /// @param b Second integer
+    /// @return Remainder
+    BigInt operator%(const BigInt &b) const;
+
+    /// @brief Remainder of division and assign
+    /// @param b Second integer
+    /// @return Remainder
+    BigInt &operator%=(const BigInt &b);
+
+    /// @brief Quotient and remainder of division at once
+    /// @param a Dividend
+    /// @param b Divisor
+    /// @param q Quotient, truncated toward zero
+    /// @param r Remainder, with the sign of the dividend
+    friend void divMod(const BigInt &a, const BigInt &b, BigInt &q, BigInt &r);
+
+    /// @brief Greatest common divisor, by Lehmer's algorithm while operands are
+    /// multi-limb and binary GCD once they fit in a machine word
+    /// @param a First integer
+    /// @param b Second integer
+    /// @return Nonnegative GCD
+    friend BigInt gcd(const BigInt &a, const BigInt &b);
+
+    /// @brief Print integer
+    /// @param os ostream
+    /// @param b Integer
+    /// @return Given stream with integer
+    friend std::ostream &operator<<(std::ostream &os, const BigInt &b);
+
+private:
+    /// @brief Inline value, used when there are no limbs
+    int64_t small;
+
+    /// @brief Sign of value stored in limbs
+    bool negative;
+
+    /// @brief Little-endian magnitude, only used for values not fitting in 64 bits
+    std::vector<uint32_t> limbs;
+
+    /// @brief Magnitude of value as limbs, regardless of storage
+    /// @return Little-endian limbs
+    std::vector<uint32_t> magnitude() const;
+
+    /// @brief Magnitude of value as limbs, borrowing the limbs when allocated
+    /// @param scratch Holds the limbs of an inline value
+    /// @return Little-endian limbs, either this integer's or scratch
+    const std::vector<uint32_t> &magnitude(std::vector<uint32_t> &scratch) const;
+
+    /// @brief Sum or difference of two integers, for values not fitting the inline fast path
+    /// @param a First integer
+    /// @param b Second integer
+    /// @param subtract Whether to subtract b instead of adding it
+    /// @return Resulting integer
+    static BigInt addSigned(const BigInt &a, const BigInt &b, const bool &subtract);
+
+    /// @brief Builds normalized integer from sign and magnitude, moving back inline when it fits
+    /// @param negative Sign
+    /// @param mag Little-endian limbs
+    /// @return Resulting integer
+    static BigInt fromMagnitude(const bool &negative, std::vector<uint32_t> &&mag);
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdlib>
+
+// Cofactor closed forms of the determinant and adjugate of orders 2, 3 and 4.
+//
+// Written for any cell type with +, - and *, so the same straight-line code
+// serves Matrix cells and the vector registers of the batched kernels. Order
+// 4 shares the 12 2x2 minors of rows 0-1 and of rows 2-3 between the
+// determinant and every cofactor. Always inlined, so the batched kernels
+// compile them for their own instruction set
+
+/// @brief Closed-form determinant of a square array of cells
+/// @tparam V Cell type, or a vector type holding that cell of several matrices
+/// @param a Cells
+/// @param det Determinant
+template <size_t N, typename V>
+__attribute__((always_inline)) inline void cofactorDeterminant(const V (&a)[N][N], V &det)
+{
+    static_assert(N >= 2 && N <= 4, "Closed-form determinant is defined for orders 2 to 4");
+
+    if constexpr (N == 2)
+        det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    else if constexpr (N == 3)
+    {
+        det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) +
+              a[0][1] * (a[1][2] * a[2][0] - a[1][0] * a[2][2]) +
+              a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    }
+    else
+    {
+        // Laplace expansion along the first 2 rows, with the 2x2 minors of each row pair
+        const V s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+        const V s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+        const V s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+        const V s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+        const V s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+        const V s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+        const V c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+        const V c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+        const V c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+        const V c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+        const V c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+        const V c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+
+        det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+}
+
+/// @brief Closed-form adjugate, the transposed cofactor matrix, of a square array of cells
+/// @tparam V Cell type, or a vector type holding that cell of several matrices
+/// @param a Cells
+/// @param adj Adjugate cells
+/// @param det Determinant
+template <size_t N, typename V>
+__attribute__((always_inline)) inline void cofactorAdjugate(const V (&a)[N][N], V (&adj)[N][N], V &det)
+{
+    static_assert(N >= 2 && N <= 4, "Closed-form adjugate is defined for orders 2 to 4");
+
+    if constexpr (N == 2)
+    {
+        adj[0][0] = a[1][1];
+        adj[0][1] = -a[0][1];
+        adj[1][0] = -a[1][0];
+        adj[1][1] = a[0][0];
+        det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    }
+    else if constexpr (N == 3)
+    {
+        adj[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+        adj[0][1] = a[0][2] * a[2][1] - a[0][1] * a[2][2];
+        adj[0][2] = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+        adj[1][0] = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+        adj[1][1] = a[0][0] * a[2][2] - a[0][2] * a[2][0];
+        adj[1][2] = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+        adj[2][0] = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+        adj[2][1] = a[0][1] * a[2][0] - a[0][0] * a[2][1];
+        adj[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+        det = a[0][0] * adj[0][0] + a[0][1] * adj[1][0] + a[0][2] * adj[2][0];
+    }
+    else
+    {
+        // Every cofactor is a combination of the 2x2 minors of rows 0-1 and of rows 2-3
+        const V s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+        const V s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+        const V s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+        const V s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+        const V s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+        const V s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+        const V c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+        const V c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+        const V c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+        const V c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+        const V c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+        const V c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+
+        adj[0][0] = a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3;
+        adj[0][1] = a[0][2] * c4 - a[0][1] * c5 - a[0][3] * c3;
+        adj[0][2] = a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3;
+        adj[0][3] = a[2][2] * s4 - a[2][1] * s5 - a[2][3] * s3;
+        adj[1][0] = a[1][2] * c2 - a[1][0] * c5 - a[1][3] * c1;
+        adj[1][1] = a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1;
+        adj[1][2] = a[3][2] * s2 - a[3][0] * s5 - a[3][3] * s1;
+        adj[1][3] = a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1;
+        adj[2][0] = a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0;
+        adj[2][1] = a[0][1] * c2 - a[0][0] * c4 - a[0][3] * c0;
+        adj[2][2] = a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0;
+        adj[2][3] = a[2][1] * s2 - a[2][0] * s4 - a[2][3] * s0;
+        adj[3][0] = a[1][1] * c1 - a[1][0] * c3 - a[1][2] * c0;
+        adj[3][1] = a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0;
+        adj[3][2] = a[3][1] * s1 - a[3][0] * s3 - a[3][2] * s0;
+        adj[3][3] = a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0;
+
+        det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+}
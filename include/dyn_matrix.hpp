@@ -0,0 +1,1210 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+#include <include/matrix_view.hpp>
+#include <include/simd.hpp>
+
+/// @brief Alignment of DynMatrix storage and of every row start, in bytes (one cache line)
+constexpr size_t dynMatrixAlignment = 64;
+
+/// @brief Matrix with order only known at runtime
+/// @tparam T Matrix data type
+template <typename T>
+class DynMatrix;
+
+/// @brief Right side product of scalar and matrix
+/// @param s Scalar value
+/// @param m Matrix
+/// @return Result of product
+template <typename T>
+DynMatrix<T> operator*(const T &s, const DynMatrix<T> &m);
+
+/// @brief Right side product of scalar and a temporary matrix, reusing its storage
+/// @param s Scalar value
+/// @param m Matrix
+/// @return Result of product
+template <typename T>
+DynMatrix<T> operator*(const T &s, DynMatrix<T> &&m);
+
+/// @brief Addition of a matrix and a temporary matrix, reusing the temporary's storage
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of addition
+template <typename T>
+DynMatrix<T> operator+(const DynMatrix<T> &m0, DynMatrix<T> &&m1);
+
+/// @brief Addition of 2 temporary matrices, reusing the left one's storage
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of addition
+template <typename T>
+DynMatrix<T> operator+(DynMatrix<T> &&m0, DynMatrix<T> &&m1);
+
+/// @brief Difference of a matrix and a temporary matrix, reusing the temporary's storage
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of subtraction
+template <typename T>
+DynMatrix<T> operator-(const DynMatrix<T> &m0, DynMatrix<T> &&m1);
+
+/// @brief Difference of 2 temporary matrices, reusing the left one's storage
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of subtraction
+template <typename T>
+DynMatrix<T> operator-(DynMatrix<T> &&m0, DynMatrix<T> &&m1);
+
+/// @brief Calculates matrix determinant by Gaussian elimination
+/// @tparam T matrix data type
+/// @param m Matrix
+/// @return Matrix's determinant
+template <typename T>
+T rowReductionDeterminant(const DynMatrix<T> &m);
+
+/// @brief Calculates matrix inverse by Gauss-Jordan elimination
+/// @tparam T matrix data type
+/// @param m Matrix
+/// @return Matrix's inverse, or an empty matrix if it has no inverse
+template <typename T>
+DynMatrix<T> gaussJordanInverse(const DynMatrix<T> &m);
+
+template <typename T>
+class DynMatrix
+{
+public:
+    /// @brief Empty constructor, matrix of order 0x0
+    DynMatrix();
+
+    /// @brief Constructor with matrix order and initial value
+    /// @param r Number of rows
+    /// @param c Number of columns
+    /// @param v Optional initial value for each cell
+    DynMatrix(const size_t &r, const size_t &c, const T &v = T{0});
+
+    /// @brief Constructor from fixed-size matrix
+    /// @param m Matrix to be copied
+    template <size_t R, size_t C>
+    DynMatrix(const Matrix<R, C, T> &m);
+
+    /// @brief Copy constructor
+    /// @param m Matrix to be copied
+    DynMatrix(const DynMatrix<T> &m);
+
+    /// @brief Move constructor, leaves the source as a 0x0 matrix
+    /// @param m Matrix to be moved
+    DynMatrix(DynMatrix<T> &&m) noexcept;
+
+    /// @brief Destructor
+    ~DynMatrix();
+
+    /// @brief Number of rows
+    size_t rows() const;
+
+    /// @brief Number of columns
+    size_t cols() const;
+
+    /// @brief Distance in cells between the starts of two consecutive rows.
+    /// Rows are padded so that each one starts on a cache line
+    size_t stride() const;
+
+    /// @brief Pointer to first cell of a row
+    /// @param r Row
+    /// @return Row pointer, so cells can be accessed as m[i][j]
+    T *operator[](const size_t &r);
+
+    /// @brief Pointer to first cell of a row
+    /// @param r Row
+    /// @return Row pointer, so cells can be accessed as m[i][j]
+    const T *operator[](const size_t &r) const;
+
+    /// @brief Copy cells into a fixed-size matrix, order must match
+    /// @return Fixed-size matrix with the same data
+    template <size_t R, size_t C>
+    Matrix<R, C, T> toMatrix() const;
+
+    /// @brief Transpose of this matrix
+    /// @return This matrix transposed
+    DynMatrix<T> transpose() const;
+
+    /// @brief Read-only view of all cells, for the view* kernels
+    MatrixView<T> view() const;
+
+    /// @brief Writable view of all cells, for the view* kernels
+    MatrixSpan<T> span();
+
+    /// @brief Calculate this matrix's determinant
+    /// @return The calculated determinant
+    T determinant() const;
+
+    /// @brief Tries to calculate inverse of this matrix
+    /// @return The inverse of this matrix, or an empty matrix if determinant = 0
+    DynMatrix<T> inverse() const;
+
+    /// @brief Copy assign operator
+    /// @param m Matrix to be copied
+    /// @return Copied matrix
+    DynMatrix<T> &operator=(const DynMatrix<T> &m);
+
+    /// @brief Move assign operator
+    /// @param m Matrix to be moved
+    /// @return Moved matrix
+    DynMatrix<T> &operator=(DynMatrix<T> &&m) noexcept;
+
+    /// @brief Equal check operator
+    /// @param m Other matrix
+    /// @return Whether 2 matrices have the same order and data
+    bool operator==(const DynMatrix<T> &m) const;
+
+    /// @brief Not equal check operator
+    /// @param m Other matrix
+    /// @return Whether 2 matrices have different order or data
+    bool operator!=(const DynMatrix<T> &m) const;
+
+    /// @brief Addition of 2 matrices
+    /// @param m Other matrix
+    /// @return Result of addition
+    DynMatrix<T> operator+(const DynMatrix<T> &m) const &;
+
+    /// @brief Addition of 2 matrices, reusing this temporary's storage
+    /// @param m Other matrix
+    /// @return Result of addition
+    DynMatrix<T> operator+(const DynMatrix<T> &m) &&;
+
+    /// @brief Addition of 2 matrices, then assign
+    /// @param m Other matrix
+    /// @return Result of addition
+    DynMatrix<T> &operator+=(const DynMatrix<T> &m);
+
+    /// @brief Difference of 2 matrices
+    /// @param m Other matrix
+    /// @return Result of subtraction
+    DynMatrix<T> operator-(const DynMatrix<T> &m) const &;
+
+    /// @brief Difference of 2 matrices, reusing this temporary's storage
+    /// @param m Other matrix
+    /// @return Result of subtraction
+    DynMatrix<T> operator-(const DynMatrix<T> &m) &&;
+
+    /// @brief Difference of 2 matrices, then assign
+    /// @param m Other matrix
+    /// @return Result of subtraction
+    DynMatrix<T> &operator-=(const DynMatrix<T> &m);
+
+    /// @brief Negative matrix operator
+    /// @return This matrix, with all cell's signs flipped
+    DynMatrix<T> operator-() const &;
+
+    /// @brief Negative matrix operator, reusing this temporary's storage
+    /// @return This matrix, with all cell's signs flipped
+    DynMatrix<T> operator-() &&;
+
+    /// @brief Product of 2 matrices
+    /// @param m Other matrix
+    /// @return Result of product
+    DynMatrix<T> operator*(const DynMatrix<T> &m) const;
+
+    /// @brief Product of 2 matrices, then assign
+    /// @param m Other matrix
+    /// @return Result of product
+    DynMatrix<T> &operator*=(const DynMatrix<T> &m);
+
+    /// @brief Product of scalar and matrix
+    /// @param s Scalar value
+    /// @return Result of product
+    DynMatrix<T> operator*(const T &s) const &;
+
+    /// @brief Product of scalar and matrix, reusing this temporary's storage
+    /// @param s Scalar value
+    /// @return Result of product
+    DynMatrix<T> operator*(const T &s) &&;
+
+    /// @brief Product of scalar and matrix, then assign
+    /// @param s Scalar value
+    /// @return Result of product
+    DynMatrix<T> &operator*=(const T &s);
+
+    /// @brief Division of matrix by scalar
+    /// @param s Scalar value
+    /// @return Result of division
+    DynMatrix<T> operator/(const T &s) const &;
+
+    /// @brief Division of matrix by scalar, reusing this temporary's storage
+    /// @param s Scalar value
+    /// @return Result of division
+    DynMatrix<T> operator/(const T &s) &&;
+
+    /// @brief Division of matrix by scalar, then assign
+    /// @param s Scalar value
+    /// @return Result of division
+    DynMatrix<T> &operator/=(const T &s);
+
+    /// @brief Identity matrix
+    /// @param o Matrix order
+    /// @return Identity matrix with given order
+    static DynMatrix<T> identity(const size_t &o);
+
+    /// @brief Elementary operation - swap two rows
+    /// @param r0 first row
+    /// @param r1 second row
+    void swapRows(const size_t &r0, const size_t &r1);
+
+    /// @brief Elementary operation - multiply row by scalar
+    /// @param r row to be multiplied
+    /// @param s scalar value
+    void multiplyRow(const size_t &r, const T &s);
+
+    /// @brief Elementary operation - add on row another row multiplied by scalar
+    /// @param r0 row to be added
+    /// @param r1 row which will be multiplied and added on top of r0
+    /// @param s scalar value
+    void addScaledRow(const size_t &r0, const size_t &r1, const T &s = T{1});
+
+private:
+    /// @brief Number of rows
+    size_t nRows = 0;
+
+    /// @brief Number of columns
+    size_t nCols = 0;
+
+    /// @brief Row stride, in cells
+    size_t rowStride = 0;
+
+    /// @brief Contiguous, aligned storage of nRows * rowStride cells
+    T *data = nullptr;
+
+    /// @brief Alignment used for the storage, at least one cache line
+    static constexpr std::align_val_t alignment{alignof(T) > dynMatrixAlignment ? alignof(T) : dynMatrixAlignment};
+
+    /// @brief Allocates memory for matrix data, without touching any previous storage
+    /// @param r Number of rows
+    /// @param c Number of columns
+    /// @param v Initial cell value
+    void alloc(const size_t &r, const size_t &c, const T &v);
+
+    /// @brief Frees memory of matrix data
+    void free();
+};
+
+template <typename T>
+void DynMatrix<T>::alloc(const size_t &r, const size_t &c, const T &v)
+{
+    nRows = r;
+    nCols = c;
+
+    // Pad rows to whole cache lines whenever a line holds a whole number of cells
+    const size_t perLine = dynMatrixAlignment % sizeof(T) == 0 ? dynMatrixAlignment / sizeof(T) : 1;
+    rowStride = (c + perLine - 1) / perLine * perLine;
+
+    const size_t n = r * rowStride;
+    if (n == 0)
+    {
+        data = nullptr;
+        return;
+    }
+
+    data = static_cast<T *>(::operator new(n * sizeof(T), alignment));
+    try
+    {
+        // Padding cells are initialized too, so copies and destruction cover the whole buffer
+        std::uninitialized_fill_n(data, n, v);
+    }
+    catch (...)
+    {
+        ::operator delete(data, alignment);
+        data = nullptr;
+        throw;
+    }
+}
+
+template <typename T>
+void DynMatrix<T>::free()
+{
+    if (data != nullptr)
+    {
+        std::destroy_n(data, nRows * rowStride);
+        ::operator delete(data, alignment);
+    }
+    data = nullptr;
+    nRows = nCols = rowStride = 0;
+}
+
+template <typename T>
+DynMatrix<T>::DynMatrix()
+{
+}
+
+template <typename T>
+DynMatrix<T>::DynMatrix(const size_t &r, const size_t &c, const T &v)
+{
+    alloc(r, c, v);
+}
+
+template <typename T>
+template <size_t R, size_t C>
+DynMatrix<T>::DynMatrix(const Matrix<R, C, T> &m)
+{
+    alloc(R, C, T{0});
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            (*this)[i][j] = m.data[i][j];
+        }
+    }
+}
+
+template <typename T>
+DynMatrix<T>::DynMatrix(const DynMatrix<T> &m)
+    : nRows{m.nRows}, nCols{m.nCols}, rowStride{m.rowStride}
+{
+    const size_t n = nRows * rowStride;
+    if (n == 0)
+        return;
+
+    data = static_cast<T *>(::operator new(n * sizeof(T), alignment));
+    try
+    {
+        std::uninitialized_copy_n(m.data, n, data);
+    }
+    catch (...)
+    {
+        ::operator delete(data, alignment);
+        data = nullptr;
+        throw;
+    }
+}
+
+template <typename T>
+DynMatrix<T>::DynMatrix(DynMatrix<T> &&m) noexcept
+    : nRows{m.nRows}, nCols{m.nCols}, rowStride{m.rowStride}, data{m.data}
+{
+    m.nRows = m.nCols = m.rowStride = 0;
+    m.data = nullptr;
+}
+
+template <typename T>
+DynMatrix<T>::~DynMatrix()
+{
+    free();
+}
+
+template <typename T>
+size_t DynMatrix<T>::rows() const
+{
+    return nRows;
+}
+
+template <typename T>
+size_t DynMatrix<T>::cols() const
+{
+    return nCols;
+}
+
+template <typename T>
+size_t DynMatrix<T>::stride() const
+{
+    return rowStride;
+}
+
+template <typename T>
+T *DynMatrix<T>::operator[](const size_t &r)
+{
+    assert((r < nRows) && "Row out of range");
+    return data + r * rowStride;
+}
+
+template <typename T>
+const T *DynMatrix<T>::operator[](const size_t &r) const
+{
+    assert((r < nRows) && "Row out of range");
+    return data + r * rowStride;
+}
+
+template <typename T>
+template <size_t R, size_t C>
+Matrix<R, C, T> DynMatrix<T>::toMatrix() const
+{
+    assert((nRows == R && nCols == C) && "Matrix order doesn't match");
+
+    Matrix<R, C, T> m{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            m.data[i][j] = (*this)[i][j];
+        }
+    }
+
+    return m;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::identity(const size_t &o)
+{
+    DynMatrix<T> m{o, o, T{0}};
+    for (size_t i = 0; i < o; ++i)
+    {
+        m[i][i] = T{1};
+    }
+
+    return m;
+}
+
+template <typename T>
+MatrixView<T> DynMatrix<T>::view() const
+{
+    return MatrixView<T>{data, nRows, nCols, rowStride};
+}
+
+template <typename T>
+MatrixSpan<T> DynMatrix<T>::span()
+{
+    return MatrixSpan<T>{data, nRows, nCols, rowStride};
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::transpose() const
+{
+    DynMatrix<T> m{nCols, nRows};
+
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        const T *row = (*this)[i];
+        for (size_t j = 0; j < nCols; ++j)
+        {
+            m[j][i] = row[j];
+        }
+    }
+
+    return m;
+}
+
+template <typename T>
+T rowReductionDeterminant(const DynMatrix<T> &m)
+{
+    assert((m.rows() == m.cols()) && "Determinant is defined only for square matrices");
+
+    const size_t o = m.rows();
+
+    // Create a copy of this matrix
+    DynMatrix<T> tmp{m};
+
+    // Save determinant scale
+    T scale = T{1};
+
+    // Perform elementary operations based on current working column
+    // until reached upper triangle form
+    for (size_t c = 0; c < o; ++c)
+    {
+        // Find first nonzero row
+        size_t row = -1;
+        for (size_t i = c; i < o; ++i)
+        {
+            if (tmp[i][c] != T{0})
+            {
+                row = i;
+                break;
+            }
+        }
+        if (row == -1UL)
+        {
+            // Entire column is zero, can't reach identity
+            printf("No inverse: reached a state where column %ld is null\n\n", c);
+            return T{0};
+        }
+
+        // If first nonzero row is not the same as current working column, swap rows
+        if (row != c)
+        {
+            tmp.swapRows(row, c);
+            // Multiply scale by -1 when swapping rows
+            scale *= T{-1};
+        }
+
+        // Make sure row[c] is 1
+        T rowScale = tmp[c][c];
+        if (rowScale != T{1})
+        {
+            // Multiply by inverse
+            T mult = T{1} / rowScale;
+            tmp.multiplyRow(c, mult);
+            // Change determinant scale too
+            scale *= rowScale;
+        }
+
+        // Make sure all other rows have zeros on this column
+        for (size_t i = c + 1; i < o; ++i)
+        {
+            // If already zero, skip
+            T elem = tmp[i][c];
+            if (elem == T{0})
+                continue;
+
+            // Add the opposite
+            tmp.addScaledRow(i, c, -elem);
+        }
+    }
+
+    return scale;
+}
+
+/// @brief Checks whether every cell of a fraction matrix is an integer
+/// @param m Matrix
+/// @return Whether all cells have denominator 1
+inline bool hasIntegerEntries(const DynMatrix<Fraction> &m)
+{
+    for (size_t i = 0; i < m.rows(); ++i)
+    {
+        for (size_t j = 0; j < m.cols(); ++j)
+        {
+            if (m[i][j].denominator != 1)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Calculates determinant of an integer fraction matrix by Bareiss fraction-free elimination.
+/// Works only on numerators, so no GCD is ever evaluated
+/// @param m Matrix, all cells must have denominator 1
+/// @return Matrix's determinant
+/// @throws std::overflow_error if a minor doesn't fit in 64 bits
+inline Fraction bareissDeterminant(const DynMatrix<Fraction> &m)
+{
+    assert((m.rows() == m.cols()) && "Determinant is defined only for square matrices");
+    assert(hasIntegerEntries(m) && "Bareiss elimination requires integer cells");
+
+    const size_t o = m.rows();
+    if (o == 0)
+    {
+        return 0;
+    }
+
+    DynMatrix<int64_t> a{o, o};
+    std::vector<int64_t *> rows(o);
+    for (size_t i = 0; i < o; ++i)
+    {
+        rows[i] = a[i];
+        for (size_t j = 0; j < o; ++j)
+        {
+            a[i][j] = m[i][j].numerator;
+        }
+    }
+
+    int64_t prev, sign;
+    if (bareissEliminate(rows.data(), o, o, false, prev, sign) != o)
+    {
+        // Entire column is zero
+        return 0;
+    }
+
+    return Fraction{sign * prev};
+}
+
+/// @brief Calculates inverse of an integer fraction matrix by fraction-free Gauss-Jordan elimination.
+/// Left side of the augmented matrix ends as det * I, so the inverse is the right side divided by det
+/// @param m Matrix, all cells must have denominator 1
+/// @return Matrix's inverse, or an empty matrix if it has no inverse
+/// @throws std::overflow_error if a minor doesn't fit in 64 bits
+inline DynMatrix<Fraction> bareissInverse(const DynMatrix<Fraction> &m)
+{
+    assert((m.rows() == m.cols()) && "Inverse of matrix is defined only for square matrices");
+    assert(hasIntegerEntries(m) && "Bareiss elimination requires integer cells");
+
+    const size_t o = m.rows();
+
+    // Left side is current matrix, right side is identity
+    DynMatrix<int64_t> a{o, 2 * o};
+    std::vector<int64_t *> rows(o);
+    for (size_t i = 0; i < o; ++i)
+    {
+        rows[i] = a[i];
+        for (size_t j = 0; j < o; ++j)
+        {
+            a[i][j] = m[i][j].numerator;
+        }
+        a[i][i + o] = 1;
+    }
+
+    int64_t prev, sign;
+    const size_t null = bareissEliminate(rows.data(), o, 2 * o, true, prev, sign);
+    if (null != o)
+    {
+        // Entire column is zero, can't reach identity
+        printf("No inverse: reached a state where column %ld is null\n\n", null);
+        return DynMatrix<Fraction>();
+    }
+
+    // Last pivot is the determinant (up to sign), shared by the whole left diagonal
+    DynMatrix<Fraction> res{o, o};
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            res[i][j] = Fraction{rows[i][j + o], prev};
+            res[i][j].reduce();
+        }
+    }
+
+    return res;
+}
+
+template <typename T>
+T DynMatrix<T>::determinant() const
+{
+    // Integer fraction matrices can skip every intermediate reduction. Minors may outgrow
+    // 64 bits where reduced fractions don't, so those fall back on checked elimination
+    if constexpr (std::is_same_v<T, Fraction>)
+    {
+        if (hasIntegerEntries(*this))
+        {
+            try
+            {
+                return bareissDeterminant(*this);
+            }
+            catch (const std::overflow_error &)
+            {
+            }
+        }
+    }
+
+    return rowReductionDeterminant(*this);
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::inverse() const
+{
+    // Integer fraction matrices can skip every intermediate reduction. Minors may outgrow
+    // 64 bits where reduced fractions don't, so those fall back on checked elimination
+    if constexpr (std::is_same_v<T, Fraction>)
+    {
+        if (hasIntegerEntries(*this))
+        {
+            try
+            {
+                return bareissInverse(*this);
+            }
+            catch (const std::overflow_error &)
+            {
+            }
+        }
+    }
+
+    return gaussJordanInverse(*this);
+}
+
+template <typename T>
+DynMatrix<T> gaussJordanInverse(const DynMatrix<T> &m)
+{
+    assert((m.rows() == m.cols()) && "Inverse of matrix is defined only for square matrices");
+
+    const size_t o = m.rows();
+
+    // Create matrix of order (o, 2o)
+    // Left side is current matrix, right side is identity
+    DynMatrix<T> inv{o, 2 * o};
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            inv[i][j] = m[i][j];
+        }
+        inv[i][i + o] = T{1};
+    }
+
+    // Perform elementary operations based on current working column
+    // until left side is an identity matrix
+    for (size_t c = 0; c < o; ++c)
+    {
+        // Find first nonzero row
+        size_t row = -1;
+        for (size_t i = c; i < o; ++i)
+        {
+            if (inv[i][c] != T{0})
+            {
+                row = i;
+                break;
+            }
+        }
+        if (row == -1UL)
+        {
+            // Entire column is zero, can't reach identity
+            printf("No inverse: reached a state where column %ld is null\n\n", c);
+            return DynMatrix<T>();
+        }
+
+        // If first nonzero row is not the same as current working column, swap rows
+        if (row != c)
+        {
+            inv.swapRows(row, c);
+        }
+
+        // Make sure row[c] is 1
+        T elem = inv[c][c];
+        if (elem != T{1})
+        {
+            // Multiply by inverse
+            T mult = T{1} / elem;
+            inv.multiplyRow(c, mult);
+        }
+
+        // Make sure all other rows have zeros on this column
+        for (size_t i = 0; i < o; ++i)
+        {
+            // Don't change current row
+            if (i == c)
+                continue;
+
+            // If already zero, skip
+            T elem = inv[i][c];
+            if (elem == T{0})
+                continue;
+
+            // Add the opposite
+            inv.addScaledRow(i, c, -elem);
+        }
+    }
+
+    // Create matrix using only right side of result
+    DynMatrix<T> res{o, o};
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            res[i][j] = inv[i][j + o];
+        }
+    }
+
+    return res;
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const DynMatrix<T> &m)
+{
+    for (size_t i = 0; i < m.rows(); ++i)
+    {
+        os << "[";
+        for (size_t j = 0; j < m.cols(); ++j)
+        {
+            os << m[i][j];
+            if (j != m.cols() - 1)
+            {
+                os << " ";
+            }
+        }
+        os << "]";
+        if (i != m.rows() - 1)
+        {
+            os << "\n";
+        }
+    }
+
+    return os;
+}
+
+template <typename T>
+DynMatrix<T> &DynMatrix<T>::operator=(const DynMatrix<T> &m)
+{
+    if (this == &m)
+        return *this;
+
+    // Same order reuses the current storage
+    if (nRows == m.nRows && nCols == m.nCols)
+    {
+        std::copy_n(m.data, nRows * rowStride, data);
+        return *this;
+    }
+
+    DynMatrix<T> tmp{m};
+    return *this = std::move(tmp);
+}
+
+template <typename T>
+DynMatrix<T> &DynMatrix<T>::operator=(DynMatrix<T> &&m) noexcept
+{
+    std::swap(nRows, m.nRows);
+    std::swap(nCols, m.nCols);
+    std::swap(rowStride, m.rowStride);
+    std::swap(data, m.data);
+
+    return *this;
+}
+
+template <typename T>
+bool DynMatrix<T>::operator==(const DynMatrix<T> &m) const
+{
+    if (nRows != m.nRows || nCols != m.nCols)
+        return false;
+
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        const T *a = (*this)[i];
+        const T *b = m[i];
+        for (size_t j = 0; j < nCols; ++j)
+        {
+            if (a[j] != b[j])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+bool DynMatrix<T>::operator!=(const DynMatrix<T> &m) const
+{
+    return !(*this == m);
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator+(const DynMatrix<T> &m) const &
+{
+    DynMatrix<T> tmp{*this};
+    tmp += m;
+    return tmp;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator+(const DynMatrix<T> &m) &&
+{
+    *this += m;
+    return std::move(*this);
+}
+
+template <typename T>
+DynMatrix<T> operator+(const DynMatrix<T> &m0, DynMatrix<T> &&m1)
+{
+    // Addition commutes, so the result can be accumulated on the right side
+    m1 += m0;
+    return std::move(m1);
+}
+
+template <typename T>
+DynMatrix<T> operator+(DynMatrix<T> &&m0, DynMatrix<T> &&m1)
+{
+    m0 += m1;
+    return std::move(m0);
+}
+
+template <typename T>
+DynMatrix<T> &DynMatrix<T>::operator+=(const DynMatrix<T> &m)
+{
+    assert((nRows == m.nRows && nCols == m.nCols) && "Matrix order doesn't match");
+
+    // Same order means same stride, so both buffers line up, padding included
+    if constexpr (hasSimd<T>)
+    {
+        if (nRows * rowStride >= simdMinimumCells)
+        {
+            simdAdd(data, m.data, nRows * rowStride);
+            return *this;
+        }
+    }
+
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        T *a = (*this)[i];
+        const T *b = m[i];
+        for (size_t j = 0; j < nCols; ++j)
+        {
+            a[j] += b[j];
+        }
+    }
+
+    return *this;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator-(const DynMatrix<T> &m) const &
+{
+    DynMatrix<T> tmp{*this};
+    tmp -= m;
+    return tmp;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator-(const DynMatrix<T> &m) &&
+{
+    *this -= m;
+    return std::move(*this);
+}
+
+template <typename T>
+DynMatrix<T> operator-(const DynMatrix<T> &m0, DynMatrix<T> &&m1)
+{
+    assert((m0.rows() == m1.rows() && m0.cols() == m1.cols()) && "Matrix order doesn't match");
+
+    if constexpr (hasSimd<T>)
+    {
+        if (m1.rows() * m1.stride() >= simdMinimumCells)
+        {
+            simdReverseSubtract(m1[0], m0[0], m1.rows() * m1.stride());
+            return std::move(m1);
+        }
+    }
+
+    for (size_t i = 0; i < m1.rows(); ++i)
+    {
+        const T *a = m0[i];
+        T *b = m1[i];
+        for (size_t j = 0; j < m1.cols(); ++j)
+        {
+            b[j] = a[j] - b[j];
+        }
+    }
+
+    return std::move(m1);
+}
+
+template <typename T>
+DynMatrix<T> operator-(DynMatrix<T> &&m0, DynMatrix<T> &&m1)
+{
+    m0 -= m1;
+    return std::move(m0);
+}
+
+template <typename T>
+DynMatrix<T> &DynMatrix<T>::operator-=(const DynMatrix<T> &m)
+{
+    assert((nRows == m.nRows && nCols == m.nCols) && "Matrix order doesn't match");
+
+    if constexpr (hasSimd<T>)
+    {
+        if (nRows * rowStride >= simdMinimumCells)
+        {
+            simdSubtract(data, m.data, nRows * rowStride);
+            return *this;
+        }
+    }
+
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        T *a = (*this)[i];
+        const T *b = m[i];
+        for (size_t j = 0; j < nCols; ++j)
+        {
+            a[j] -= b[j];
+        }
+    }
+
+    return *this;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator-() const &
+{
+    DynMatrix<T> m{*this};
+    return -std::move(m);
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator-() &&
+{
+    if constexpr (hasSimd<T>)
+    {
+        if (nRows * rowStride >= simdMinimumCells)
+        {
+            simdNegate(data, nRows * rowStride);
+            return std::move(*this);
+        }
+    }
+
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        T *row = (*this)[i];
+        for (size_t j = 0; j < nCols; ++j)
+        {
+            row[j] = -row[j];
+        }
+    }
+
+    return std::move(*this);
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator*(const DynMatrix<T> &m) const
+{
+    assert((nCols == m.nRows) && "Left matrix's columns must match right matrix's rows");
+
+    DynMatrix<T> res{nRows, m.nCols};
+
+    // Large float and double products go through the packed, cache-blocked kernel
+    if constexpr (hasGemm<T>)
+    {
+        if (nRows * nCols * m.nCols >= gemmThreshold)
+        {
+            gemm(nRows, m.nCols, nCols, data, rowStride, m.data, m.rowStride, res.data, res.rowStride);
+            return res;
+        }
+    }
+
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        const T *a = (*this)[i];
+        T *out = res[i];
+
+        // Fractions accumulate over a common denominator and reduce once per cell
+        if constexpr (std::is_same_v<T, Fraction>)
+        {
+            for (size_t j = 0; j < m.nCols; ++j)
+                out[j] = dotProduct(a, 1, m.data + j, m.rowStride, nCols);
+            continue;
+        }
+
+        // Walk both matrices along rows, so the inner loop is contiguous
+        for (size_t k = 0; k < nCols; ++k)
+        {
+            const T *b = m[k];
+            for (size_t j = 0; j < m.nCols; ++j)
+                multiplyAdd(out[j], a[k], b[j]);
+        }
+    }
+
+    return res;
+}
+
+template <typename T>
+DynMatrix<T> &DynMatrix<T>::operator*=(const DynMatrix<T> &m)
+{
+    // Every cell of the product reads a whole row of this matrix, so it can't be done in place
+    return *this = *this * m;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator*(const T &s) const &
+{
+    DynMatrix<T> tmp{*this};
+    tmp *= s;
+    return tmp;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator*(const T &s) &&
+{
+    *this *= s;
+    return std::move(*this);
+}
+
+template <typename T>
+DynMatrix<T> &DynMatrix<T>::operator*=(const T &s)
+{
+    if constexpr (hasSimd<T>)
+    {
+        if (nRows * rowStride >= simdMinimumCells)
+        {
+            simdScale(data, s, nRows * rowStride);
+            return *this;
+        }
+    }
+
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        T *row = (*this)[i];
+        for (size_t j = 0; j < nCols; ++j)
+        {
+            row[j] *= s;
+        }
+    }
+
+    return *this;
+}
+
+template <typename T>
+DynMatrix<T> operator*(const T &s, const DynMatrix<T> &m)
+{
+    return m * s;
+}
+
+template <typename T>
+DynMatrix<T> operator*(const T &s, DynMatrix<T> &&m)
+{
+    return std::move(m) * s;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator/(const T &s) const &
+{
+    DynMatrix<T> tmp{*this};
+    tmp /= s;
+    return tmp;
+}
+
+template <typename T>
+DynMatrix<T> DynMatrix<T>::operator/(const T &s) &&
+{
+    *this /= s;
+    return std::move(*this);
+}
+
+template <typename T>
+DynMatrix<T> &DynMatrix<T>::operator/=(const T &s)
+{
+    return *this *= T{1} / s;
+}
+
+template <typename T>
+void DynMatrix<T>::swapRows(const size_t &r0, const size_t &r1)
+{
+    if constexpr (hasSimd<T>)
+    {
+        if (nCols >= simdMinimumCells)
+        {
+            simdSwap((*this)[r0], (*this)[r1], nCols);
+            return;
+        }
+    }
+
+    std::swap_ranges((*this)[r0], (*this)[r0] + nCols, (*this)[r1]);
+}
+
+template <typename T>
+void DynMatrix<T>::multiplyRow(const size_t &r, const T &s)
+{
+    T *row = (*this)[r];
+    if constexpr (hasSimd<T>)
+    {
+        if (nCols >= simdMinimumCells)
+        {
+            simdScale(row, s, nCols);
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < nCols; ++i)
+    {
+        row[i] *= s;
+    }
+}
+
+template <typename T>
+void DynMatrix<T>::addScaledRow(const size_t &r0, const size_t &r1, const T &s)
+{
+    T *a = (*this)[r0];
+    const T *b = (*this)[r1];
+    if constexpr (hasSimd<T>)
+    {
+        if (nCols >= simdMinimumCells)
+        {
+            simdAddScaled(a, b, s, nCols);
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < nCols; ++i)
+    {
+        multiplyAdd(a[i], s, b[i]);
+    }
+}
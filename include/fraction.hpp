@@ -2,7 +2,33 @@
 
 #include <ostream>
 #include <array>
-
+#include <cstdint>
+#include <cassert>
+#include <stdexcept>
+
+// Reduction policy, must be the same for the whole program:
+// - AUTO_REDUCE_FRACTIONS (default) reduces after every operation
+// - LAZY_REDUCE_FRACTIONS keeps fractions unreduced until a term grows past
+//   LAZY_REDUCE_THRESHOLD, so most operations skip the GCD entirely
+#ifndef LAZY_REDUCE_FRACTIONS
+#define AUTO_REDUCE_FRACTIONS
+#endif
+
+#ifndef LAZY_REDUCE_THRESHOLD
+// Terms up to 2^31 can always be multiplied without overflowing
+#define LAZY_REDUCE_THRESHOLD (INT64_C(1) << 31)
+#endif
+
+#ifdef FRACTION_COUNT_GCD
+/// @brief Number of GCD evaluations performed so far (only available with FRACTION_COUNT_GCD)
+inline uint64_t fractionGcdCount = 0;
+#endif
+
+// Defining FRACTION_GCD_HOOK(a, b) before including this header calls it with
+// the operands of every 64-bit GCD, e.g. to record realistic benchmark inputs
+
+/// @brief Fraction of two 64-bit integers. Fully defined in this header and trivially
+/// copyable, so matrix kernels can inline every operation and evaluate it at compile time
 class Fraction
 {
 public:
@@ -13,160 +39,701 @@ public:
     int64_t denominator;
 
     /// @brief Empty constructor
-    Fraction();
+    constexpr Fraction();
 
     /// @brief Constructor with only numerator
-    Fraction(const int64_t &numerator);
+    constexpr Fraction(const int64_t &numerator);
 
     /// @brief Constructor with both numerator and denominator
-    Fraction(const int64_t &numerator, const int64_t &denominator);
+    constexpr Fraction(const int64_t &numerator, const int64_t &denominator);
 
     /// @brief Constructor from array
     /// @param data Array containing numerator and denominator
-    Fraction(std::array<int64_t, 2> &data);
-
-    /// @brief Copy constructor
-    /// @param f Fraction to be copied
-    Fraction(const Fraction &f);
-
-    /// @brief Destructor
-    ~Fraction();
+    constexpr Fraction(std::array<int64_t, 2> &data);
 
     /// @brief Get inverse of fraction (raised to -1)
     /// @return Inverse of fraction
-    Fraction inverse();
+    constexpr Fraction inverse();
 
     /// @brief Evaluate fraction, that is, divide numerator by denominator
     /// @return Result of evaluated fraction
-    float eval();
+    constexpr float eval();
 
     /// @brief Reduces fraction so that numerator and denominator don't have any common divisor
-    void reduce();
-
-    /// @brief Copy assignment constructor
-    /// @param f Fraction to be copied
-    /// @return Fraction copied
-    Fraction &operator=(const Fraction &f);
+    constexpr void reduce();
 
     /// @brief Equal check operator
     /// @param f Fraction to check
     /// @return Whether 2 fractions are the same
-    bool operator==(const Fraction &f) const;
+    constexpr bool operator==(const Fraction &f) const;
 
     /// @brief Different check operator
     /// @param f Fraction to check
     /// @return Whether 2 fractions are different
-    bool operator!=(const Fraction &f) const;
+    constexpr bool operator!=(const Fraction &f) const;
 
     /// @brief Add fraction
     /// @param f Second fraction
     /// @return Result of addition
-    Fraction operator+(const Fraction &f) const;
+    constexpr Fraction operator+(const Fraction &f) const;
 
     /// @brief Add fraction and assign
     /// @param f Second fraction
     /// @return Result of addition
-    Fraction &operator+=(const Fraction &f);
+    constexpr Fraction &operator+=(const Fraction &f);
 
     /// @brief Add fraction and integer
     /// @param s Integer value
     /// @return Result of addition
-    Fraction operator+(const int64_t &s) const;
+    constexpr Fraction operator+(const int64_t &s) const;
 
     /// @brief Add fraction and integer and assign
     /// @param s Integer value
     /// @return Result of addition
-    Fraction &operator+=(const int64_t &s);
+    constexpr Fraction &operator+=(const int64_t &s);
 
     /// @brief Right-side fraction addition with integer
     /// @param s Integer value
     /// @param f Fraction
     /// @return Result of addition
-    friend Fraction operator+(const int64_t &s, const Fraction &f);
+    friend constexpr Fraction operator+(const int64_t &s, const Fraction &f);
 
     /// @brief Subtract fraction
     /// @param f Second Fraction
     /// @return Result of subtraction
-    Fraction operator-(const Fraction &f) const;
+    constexpr Fraction operator-(const Fraction &f) const;
 
     /// @brief Subtract fraction and assign
     /// @param f Second Fraction
     /// @return Result of subtraction
-    Fraction &operator-=(const Fraction &f);
+    constexpr Fraction &operator-=(const Fraction &f);
 
     /// @brief Add fraction and integer
     /// @param s Second fraction
     /// @return Result of subtraction
-    Fraction operator-(const int64_t &s) const;
+    constexpr Fraction operator-(const int64_t &s) const;
 
     /// @brief Add fraction and integer and assign
     /// @param s Second fraction
     /// @return Result of subtraction
-    Fraction &operator-=(const int64_t &s);
+    constexpr Fraction &operator-=(const int64_t &s);
 
     /// @brief Right-side fraction subtraction with integer
     /// @param s Integer value
     /// @param f Fraction
     /// @return Result of subtraction
-    friend Fraction operator-(const int64_t &s, const Fraction &f);
+    friend constexpr Fraction operator-(const int64_t &s, const Fraction &f);
 
-    Fraction operator-() const;
+    constexpr Fraction operator-() const;
 
     /// @brief Multiply fraction
     /// @param f Second Fraction
     /// @return Result of multiplication
-    Fraction operator*(const Fraction &f) const;
+    constexpr Fraction operator*(const Fraction &f) const;
 
     /// @brief Multiply fraction and assign
     /// @param f Second Fraction
     /// @return Result of multiplication
-    Fraction &operator*=(const Fraction &f);
+    constexpr Fraction &operator*=(const Fraction &f);
 
     /// @brief Multiply fraction by integer
     /// @param s Scale value
     /// @return Result of multiplication
-    Fraction operator*(const int64_t &s) const;
+    constexpr Fraction operator*(const int64_t &s) const;
 
     /// @brief Multiply fraction by integer and assign
     /// @param s Scale value
     /// @return Result of multiplication
-    Fraction &operator*=(const int64_t &s);
+    constexpr Fraction &operator*=(const int64_t &s);
 
     /// @brief Right-side fraction multiplication by integer
     /// @param s Integer value
     /// @param f Fraction
     /// @return Result of multiplication
-    friend Fraction operator*(const int64_t &s, const Fraction &f);
+    friend constexpr Fraction operator*(const int64_t &s, const Fraction &f);
 
     /// @brief Divide fraction
     /// @param f Second Fraction
     /// @return Result of division
-    Fraction operator/(const Fraction &f) const;
+    constexpr Fraction operator/(const Fraction &f) const;
 
     /// @brief Divide fraction and assign
     /// @param f Second Fraction
     /// @return Result of division
-    Fraction &operator/=(const Fraction &f);
+    constexpr Fraction &operator/=(const Fraction &f);
 
     /// @brief Divide fraction by integer
     /// @param s Scale value
     /// @return Result of division
-    Fraction operator/(const int64_t &s) const;
+    constexpr Fraction operator/(const int64_t &s) const;
 
     /// @brief Divide fraction by integer and assign
     /// @param s Scale value
     /// @return Result of division
-    Fraction &operator/=(const int64_t &s);
+    constexpr Fraction &operator/=(const int64_t &s);
 
     /// @brief Right-side fraction division by integer
     /// @param s Integer value
     /// @param f Fraction
     /// @return Result of division
-    friend Fraction operator/(const int64_t &s, const Fraction &f);
+    friend constexpr Fraction operator/(const int64_t &s, const Fraction &f);
+
+    /// @brief Fused multiply-add: adds a * b with a single reduction
+    /// @param a First factor
+    /// @param b Second factor
+    /// @return Result of accumulation
+    constexpr Fraction &addProduct(const Fraction &a, const Fraction &b);
 
-    /// @brief Print fraction
+    /// @brief Print fraction, always in lowest terms
     /// @param os ostream
     /// @param f Fraction
     /// @return Given stream with fraction
     friend std::ostream &operator<<(std::ostream &os, const Fraction &f);
-};
\ No newline at end of file
+
+private:
+    /// @brief Reduces fraction after an operation, as selected by the reduction policy
+    constexpr void autoReduce();
+
+    /// @brief Multiply by num / den after a 64-bit overflow, cross-reducing first and
+    /// using 128-bit intermediates if needed. Throws std::overflow_error if the result doesn't fit
+    /// @param num Numerator of factor
+    /// @param den Denominator of factor
+    constexpr void multiplyWide(const int64_t &num, const int64_t &den);
+};
+
+/// @brief Finds GCD (Greatest Common Divisor) of two integers by binary GCD.
+/// Each step counts the next shift on the signed difference, in parallel with the
+/// min / abs updates, which measured fastest in bench/gcd.cpp
+/// @param a First integer
+/// @param b Second integer
+/// @return Resulting GCD, nonnegative
+/// Based on: https://en.wikipedia.org/wiki/Binary_GCD_algorithm
+constexpr int64_t gcd(int64_t a, int64_t b)
+{
+#ifdef FRACTION_COUNT_GCD
+    if (!__builtin_is_constant_evaluated())
+        ++fractionGcdCount;
+#endif
+#ifdef FRACTION_GCD_HOOK
+    if (!__builtin_is_constant_evaluated())
+        FRACTION_GCD_HOOK(a, b);
+#endif
+
+    uint64_t u = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+    uint64_t v = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+    if (u == 0)
+        return (int64_t)v;
+    if (v == 0)
+        return (int64_t)u;
+
+    int uz = __builtin_ctzll(u);
+    const int vz = __builtin_ctzll(v);
+    const int shift = uz < vz ? uz : vz;
+    v >>= vz;
+    while (u != 0)
+    {
+        u >>= uz;
+        const int64_t diff = (int64_t)(v - u);
+        // Bit 63 keeps ctz defined once u == v, without changing it otherwise
+        uz = __builtin_ctzll((uint64_t)diff | (UINT64_C(1) << 63));
+        v = u < v ? u : v;
+        u = diff < 0 ? 0 - (uint64_t)diff : (uint64_t)diff;
+    }
+
+    return (int64_t)(v << shift);
+}
+
+/// @brief Counts trailing zero bits of a nonzero 128-bit integer
+/// @param v Integer
+/// @return Number of trailing zeros
+constexpr int ctz128(const unsigned __int128 &v)
+{
+    const uint64_t low = (uint64_t)v;
+    return low != 0 ? __builtin_ctzll(low) : 64 + __builtin_ctzll((uint64_t)(v >> 64));
+}
+
+/// @brief Finds GCD of two 128-bit integers by binary GCD, used on the overflow path
+/// @param a First integer
+/// @param b Second integer
+/// @return Resulting GCD, nonnegative
+constexpr __int128 gcd(__int128 a, __int128 b)
+{
+#ifdef FRACTION_COUNT_GCD
+    if (!__builtin_is_constant_evaluated())
+        ++fractionGcdCount;
+#endif
+
+    // 128-bit division is a library call, so shifts and subtractions pay off even more here
+    unsigned __int128 u = a < 0 ? 0 - (unsigned __int128)a : (unsigned __int128)a;
+    unsigned __int128 v = b < 0 ? 0 - (unsigned __int128)b : (unsigned __int128)b;
+    if (u == 0)
+        return (__int128)v;
+    if (v == 0)
+        return (__int128)u;
+
+    int uz = ctz128(u);
+    const int vz = ctz128(v);
+    const int shift = uz < vz ? uz : vz;
+    v >>= vz;
+    while (u != 0)
+    {
+        u >>= uz;
+        const __int128 diff = (__int128)(v - u);
+        uz = diff != 0 ? ctz128((unsigned __int128)diff) : 0;
+        v = u < v ? u : v;
+        u = diff < 0 ? 0 - (unsigned __int128)diff : (unsigned __int128)diff;
+    }
+
+    return (__int128)(v << shift);
+}
+
+/// @brief Stores a fraction computed with 128-bit intermediates, reducing it so it fits in 64 bits
+/// @param f Fraction to store into
+/// @param num Wide numerator
+/// @param den Wide denominator
+/// @throws std::overflow_error if the reduced fraction still doesn't fit in 64 bits
+constexpr void storeWide(Fraction &f, __int128 num, __int128 den)
+{
+    const __int128 s = gcd(num, den);
+    num /= s;
+    den /= s;
+    if (den < 0)
+    {
+        num = -num;
+        den = -den;
+    }
+
+    if (num < INT64_MIN || num > INT64_MAX || den > INT64_MAX)
+    {
+        throw std::overflow_error("Fraction does not fit in 64 bits");
+    }
+
+    f.numerator = (int64_t)num;
+    f.denominator = (int64_t)den;
+}
+
+constexpr Fraction::Fraction()
+    : Fraction{1, 1} {}
+
+constexpr Fraction::Fraction(const int64_t &numerator)
+    : Fraction{numerator, 1} {}
+
+constexpr Fraction::Fraction(std::array<int64_t, 2> &data)
+    : Fraction(data[0], data[1]) {}
+
+constexpr Fraction::Fraction(const int64_t &numerator, const int64_t &denominator)
+    : numerator{numerator},
+      denominator{denominator}
+{
+    // Denominator can't be zero
+    assert((denominator != 0) && "Denominator can't be zero");
+}
+
+constexpr Fraction Fraction::inverse()
+{
+    // Numerator can't be zero
+    assert((numerator != 0) && "Numerator can't be zero");
+    return Fraction{denominator, numerator};
+}
+
+constexpr float Fraction::eval()
+{
+    assert((denominator != 0) && "Can't eval fraction with denominator zero");
+
+    return (float)numerator / (float)denominator;
+}
+
+constexpr void Fraction::reduce()
+{
+    const int64_t s = gcd(numerator, denominator);
+    // GCD is only zero for 0/0, which the constructor rules out
+    assert((s != 0) && "GCD was zero");
+    numerator /= s;
+    denominator /= s;
+
+    // Flip signs if needed
+    if (denominator < 0)
+    {
+        if (numerator == INT64_MIN || denominator == INT64_MIN)
+        {
+            throw std::overflow_error("Fraction does not fit in 64 bits");
+        }
+        numerator *= -1;
+        denominator *= -1;
+    }
+}
+
+constexpr bool Fraction::operator==(const Fraction &f) const
+{
+    return (__int128)numerator * f.denominator == (__int128)denominator * f.numerator;
+}
+
+constexpr bool Fraction::operator!=(const Fraction &f) const
+{
+    return !(*this == f);
+}
+
+constexpr Fraction Fraction::operator+(const Fraction &f) const
+{
+    Fraction tmp{*this};
+    tmp += f;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator+=(const Fraction &f)
+{
+    int64_t ad = 0, cb = 0, num = 0, den = 0;
+    if (__builtin_mul_overflow(numerator, f.denominator, &ad) ||
+        __builtin_mul_overflow(denominator, f.numerator, &cb) ||
+        __builtin_add_overflow(ad, cb, &num) ||
+        __builtin_mul_overflow(denominator, f.denominator, &den))
+    {
+        // Products of 64-bit terms always fit in 128 bits, only their sum may not
+        __int128 wide = 0;
+        if (__builtin_add_overflow((__int128)numerator * f.denominator, (__int128)denominator * f.numerator, &wide))
+        {
+            throw std::overflow_error("Fraction does not fit in 64 bits");
+        }
+        storeWide(*this, wide, (__int128)denominator * f.denominator);
+        return *this;
+    }
+    numerator = num;
+    denominator = den;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction Fraction::operator+(const int64_t &s) const
+{
+    Fraction tmp{*this};
+    tmp += s;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator+=(const int64_t &s)
+{
+    int64_t ds = 0;
+    if (__builtin_mul_overflow(denominator, s, &ds) ||
+        __builtin_add_overflow(numerator, ds, &ds))
+    {
+        storeWide(*this, (__int128)numerator + (__int128)denominator * s, denominator);
+        return *this;
+    }
+    numerator = ds;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction operator+(const int64_t &i, const Fraction &f)
+{
+    return f + i;
+}
+
+constexpr Fraction Fraction::operator-(const Fraction &f) const
+{
+    Fraction tmp{*this};
+    tmp -= f;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator-=(const Fraction &f)
+{
+    int64_t ad = 0, cb = 0, num = 0, den = 0;
+    if (__builtin_mul_overflow(numerator, f.denominator, &ad) ||
+        __builtin_mul_overflow(denominator, f.numerator, &cb) ||
+        __builtin_sub_overflow(ad, cb, &num) ||
+        __builtin_mul_overflow(denominator, f.denominator, &den))
+    {
+        // Products of 64-bit terms always fit in 128 bits, only their difference may not
+        __int128 wide = 0;
+        if (__builtin_sub_overflow((__int128)numerator * f.denominator, (__int128)denominator * f.numerator, &wide))
+        {
+            throw std::overflow_error("Fraction does not fit in 64 bits");
+        }
+        storeWide(*this, wide, (__int128)denominator * f.denominator);
+        return *this;
+    }
+    numerator = num;
+    denominator = den;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction Fraction::operator-(const int64_t &s) const
+{
+    Fraction tmp{*this};
+    tmp -= s;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator-=(const int64_t &s)
+{
+    int64_t ds = 0;
+    if (__builtin_mul_overflow(denominator, s, &ds) ||
+        __builtin_sub_overflow(numerator, ds, &ds))
+    {
+        storeWide(*this, (__int128)numerator - (__int128)denominator * s, denominator);
+        return *this;
+    }
+    numerator = ds;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction operator-(const int64_t &s, const Fraction &f)
+{
+    return f - s;
+}
+
+constexpr Fraction Fraction::operator-() const
+{
+    if (numerator == INT64_MIN)
+    {
+        throw std::overflow_error("Fraction does not fit in 64 bits");
+    }
+
+    return {-numerator, denominator};
+}
+
+constexpr Fraction Fraction::operator*(const Fraction &f) const
+{
+    Fraction tmp{*this};
+    tmp *= f;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator*=(const Fraction &f)
+{
+    int64_t num = 0, den = 0;
+    if (__builtin_mul_overflow(numerator, f.numerator, &num) ||
+        __builtin_mul_overflow(denominator, f.denominator, &den))
+    {
+        multiplyWide(f.numerator, f.denominator);
+        return *this;
+    }
+    numerator = num;
+    denominator = den;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction Fraction::operator*(const int64_t &s) const
+{
+    Fraction tmp{*this};
+    tmp *= s;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator*=(const int64_t &s)
+{
+    int64_t num = 0;
+    if (__builtin_mul_overflow(numerator, s, &num))
+    {
+        multiplyWide(s, 1);
+        return *this;
+    }
+    numerator = num;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction operator*(const int64_t &s, const Fraction &f)
+{
+    return f * s;
+}
+
+constexpr void Fraction::multiplyWide(const int64_t &num, const int64_t &den)
+{
+    // Cross-reduce first: for reduced operands the products are then already in lowest terms
+    const int64_t g0 = gcd(numerator, den);
+    const int64_t g1 = gcd(num, denominator);
+    const int64_t a = numerator / g0, b = denominator / g1;
+    const int64_t c = num / g1, d = den / g0;
+
+    int64_t n = 0, m = 0;
+    if (__builtin_mul_overflow(a, c, &n) || __builtin_mul_overflow(b, d, &m))
+    {
+        // Only reached when the result truly needs more than 64 bits before reducing
+        storeWide(*this, (__int128)a * c, (__int128)b * d);
+        return;
+    }
+    numerator = n;
+    denominator = m;
+
+    autoReduce();
+}
+
+constexpr Fraction Fraction::operator/(const Fraction &f) const
+{
+    Fraction tmp{*this};
+    tmp /= f;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator/=(const Fraction &f)
+{
+    // Can't divide by zero
+    assert((f.numerator != 0) && "Can't divide by fraction with numerator zero");
+
+    int64_t num = 0, den = 0;
+    if (__builtin_mul_overflow(numerator, f.denominator, &num) ||
+        __builtin_mul_overflow(denominator, f.numerator, &den))
+    {
+        multiplyWide(f.denominator, f.numerator);
+        return *this;
+    }
+    numerator = num;
+    denominator = den;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction Fraction::operator/(const int64_t &s) const
+{
+    Fraction tmp{*this};
+    tmp /= s;
+    return tmp;
+}
+
+constexpr Fraction &Fraction::operator/=(const int64_t &s)
+{
+    // Can't divide by zero
+    assert((s != 0) && "Can't divide by literal zero");
+
+    int64_t den = 0;
+    if (__builtin_mul_overflow(denominator, s, &den))
+    {
+        multiplyWide(1, s);
+        return *this;
+    }
+    denominator = den;
+
+    autoReduce();
+
+    return *this;
+}
+
+constexpr Fraction operator/(const int64_t &s, const Fraction &f)
+{
+    return Fraction{s} / f;
+}
+
+constexpr void Fraction::autoReduce()
+{
+#if defined(AUTO_REDUCE_FRACTIONS)
+    reduce();
+#elif defined(LAZY_REDUCE_FRACTIONS)
+    if (numerator > LAZY_REDUCE_THRESHOLD || numerator < -LAZY_REDUCE_THRESHOLD ||
+        denominator > LAZY_REDUCE_THRESHOLD || denominator < -LAZY_REDUCE_THRESHOLD)
+    {
+        reduce();
+    }
+#endif
+}
+
+constexpr Fraction &Fraction::addProduct(const Fraction &a, const Fraction &b)
+{
+    // p/q + (r/s) * (t/u) = (p*s*u + r*t*q) / (q*s*u)
+    int64_t rt = 0, su = 0, psu = 0, rtq = 0, num = 0, den = 0;
+    if (__builtin_mul_overflow(a.numerator, b.numerator, &rt) ||
+        __builtin_mul_overflow(a.denominator, b.denominator, &su) ||
+        __builtin_mul_overflow(numerator, su, &psu) ||
+        __builtin_mul_overflow(rt, denominator, &rtq) ||
+        __builtin_add_overflow(psu, rtq, &num) ||
+        __builtin_mul_overflow(denominator, su, &den))
+    {
+        // Take the overflow-checked path, reducing the product on its own first
+        return *this += a * b;
+    }
+    numerator = num;
+    denominator = den;
+
+    autoReduce();
+
+    return *this;
+}
+
+/// @brief Dot product of two strided fraction sequences, reducing only once at the end.
+/// Accumulates an unreduced 128-bit numerator over a running common denominator,
+/// which stays unchanged while terms share denominators (e.g. rows of an inverse)
+/// @param a First sequence
+/// @param strideA Distance between consecutive elements of a
+/// @param b Second sequence
+/// @param strideB Distance between consecutive elements of b
+/// @param n Number of terms
+/// @return Sum of a[k] * b[k]
+constexpr Fraction dotProduct(const Fraction *a, const size_t &strideA,
+                              const Fraction *b, const size_t &strideB, const size_t &n)
+{
+    __int128 num = 0, den = 1;
+    size_t k = 0;
+    for (; k < n; ++k, a += strideA, b += strideB)
+    {
+        // Products of 64-bit terms always fit in 128 bits
+        const __int128 tn = (__int128)a->numerator * b->numerator;
+        const __int128 td = (__int128)a->denominator * b->denominator;
+        if (tn == 0)
+            continue;
+
+        if (td == den)
+        {
+            __int128 sum = 0;
+            if (__builtin_add_overflow(num, tn, &sum))
+                break;
+            num = sum;
+            continue;
+        }
+
+        // Move both sides to the least common multiple of the denominators
+        const __int128 g = gcd(den, td);
+        __int128 scaledNum = 0, scaledTerm = 0, lcm = 0;
+        if (__builtin_mul_overflow(num, td / g, &scaledNum) ||
+            __builtin_mul_overflow(tn, den / g, &scaledTerm) ||
+            __builtin_mul_overflow(den / g, td, &lcm) ||
+            __builtin_add_overflow(scaledNum, scaledTerm, &scaledNum))
+        {
+            break;
+        }
+        num = scaledNum;
+        den = lcm;
+    }
+
+    Fraction res{0};
+    storeWide(res, num, den);
+
+    // Accumulator outgrew 128 bits, finish term by term with the checked operators
+    for (; k < n; ++k, a += strideA, b += strideB)
+    {
+        res.addProduct(*a, *b);
+    }
+
+    return res;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const Fraction &f)
+{
+    Fraction r{f};
+    r.reduce();
+
+    os << r.numerator;
+    if (r.numerator != 0 && r.denominator != 1)
+    {
+        os << "/" << r.denominator;
+    }
+
+    return os;
+}
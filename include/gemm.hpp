@@ -0,0 +1,227 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Cache-blocked, register-tiled matrix product for float and double, after
+// the GotoBLAS / BLIS layout:
+//
+//   - B is packed into KC x NC blocks that stay in L3, split in NR-wide panels
+//   - A is packed into MC x KC blocks that stay in L2, split in MR-tall panels
+//   - a micro-kernel keeps an MR x NR tile of C in registers while streaming
+//     one A panel and one B panel (the B panel stays in L1)
+//
+// Based on: Goto, van de Geijn, "Anatomy of High-Performance Matrix Multiplication"
+// and Van Zee, van de Geijn, "BLIS: A Framework for Rapidly Instantiating BLAS Functionality"
+
+/// @brief Whether a cell type has a blocked GEMM kernel
+template <typename T>
+constexpr bool hasGemm = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/// @brief Smallest product (rows * inner * cols) dispatched to gemm() by operator*.
+/// Below it, packing costs more than the naive loop loses to cache misses
+constexpr size_t gemmThreshold = 16 * 16 * 16;
+
+/// @brief Width of the micro-kernel's vectors, in bytes (one SSE register)
+constexpr size_t gemmVectorBytes = 16;
+
+/// @brief Blocking parameters and micro-kernel of the GEMM for one cell type
+/// @tparam T float or double
+template <typename T>
+struct GemmKernel
+{
+    static_assert(hasGemm<T>, "GEMM is only implemented for float and double");
+
+    /// @brief Vector of cells, mapped to one register
+    typedef T Vec __attribute__((vector_size(gemmVectorBytes)));
+
+    /// @brief Cells per vector
+    static constexpr size_t lanes = gemmVectorBytes / sizeof(T);
+
+    /// @brief Rows of the register tile
+    static constexpr size_t MR = 6;
+
+    /// @brief Columns of the register tile, two vectors. MR * 2 accumulators, two B vectors
+    /// and one broadcast A cell fit the 16 vector registers of x86-64
+    static constexpr size_t NR = 2 * lanes;
+
+    /// @brief Depth of packed blocks, sized so that one B panel (KC x NR) stays in L1
+    static constexpr size_t KC = 256;
+
+    /// @brief Rows of a packed A block, sized so that it (MC x KC) stays in L2
+    static constexpr size_t MC = MR * (sizeof(T) == 8 ? 16 : 24);
+
+    /// @brief Columns of a packed B block
+    static constexpr size_t NC = 4080 / NR * NR;
+
+    /// @brief Unaligned vector load
+    static Vec load(const T *p)
+    {
+        Vec v;
+        memcpy(&v, p, sizeof(Vec));
+        return v;
+    }
+
+    /// @brief Unaligned vector store
+    static void store(T *p, const Vec &v)
+    {
+        memcpy(p, &v, sizeof(Vec));
+    }
+
+    /// @brief Packs an mc x kc block of A into MR-tall panels, each stored column by column.
+    /// Missing rows of the last panel are zero
+    static void packA(const size_t &mc, const size_t &kc, const T *a, const size_t &lda, T *out)
+    {
+        for (size_t i = 0; i < mc; i += MR)
+        {
+            const size_t mr = mc - i < MR ? mc - i : MR;
+            for (size_t p = 0; p < kc; ++p)
+            {
+                for (size_t r = 0; r < MR; ++r)
+                    out[r] = r < mr ? a[(i + r) * lda + p] : T{0};
+                out += MR;
+            }
+        }
+    }
+
+    /// @brief Packs a kc x nc block of B into NR-wide panels, each stored row by row.
+    /// Missing columns of the last panel are zero
+    static void packB(const size_t &kc, const size_t &nc, const T *b, const size_t &ldb, T *out)
+    {
+        for (size_t j = 0; j < nc; j += NR)
+        {
+            const size_t nr = nc - j < NR ? nc - j : NR;
+            for (size_t p = 0; p < kc; ++p)
+            {
+                const T *row = b + p * ldb + j;
+                for (size_t c = 0; c < NR; ++c)
+                    out[c] = c < nr ? row[c] : T{0};
+                out += NR;
+            }
+        }
+    }
+
+    /// @brief Multiplies an A panel by a B panel into an MR x NR tile of C
+    /// @param kc Depth of both panels
+    /// @param a Packed A panel
+    /// @param b Packed B panel
+    /// @param c Top left cell of the tile
+    /// @param ldc Row stride of C
+    /// @param mr Rows of the tile inside C
+    /// @param nr Columns of the tile inside C
+    /// @param accumulate Whether to add to C instead of overwriting it
+    static void kernel(const size_t &kc, const T *a, const T *b, T *c, const size_t &ldc,
+                       const size_t &mr, const size_t &nr, const bool &accumulate)
+    {
+        Vec acc[MR][2] = {};
+        for (size_t p = 0; p < kc; ++p)
+        {
+            const Vec b0 = load(b);
+            const Vec b1 = load(b + lanes);
+#pragma GCC unroll 8
+            for (size_t r = 0; r < MR; ++r)
+            {
+                const Vec ar = Vec{} + a[r];
+                acc[r][0] += ar * b0;
+                acc[r][1] += ar * b1;
+            }
+            a += MR;
+            b += NR;
+        }
+
+        if (mr == MR && nr == NR)
+        {
+#pragma GCC unroll 8
+            for (size_t r = 0; r < MR; ++r)
+            {
+                T *row = c + r * ldc;
+                if (accumulate)
+                {
+                    store(row, load(row) + acc[r][0]);
+                    store(row + lanes, load(row + lanes) + acc[r][1]);
+                }
+                else
+                {
+                    store(row, acc[r][0]);
+                    store(row + lanes, acc[r][1]);
+                }
+            }
+            return;
+        }
+
+        // Edge tile, only part of it lies inside C
+        T tile[MR][NR];
+        for (size_t r = 0; r < MR; ++r)
+        {
+            store(&tile[r][0], acc[r][0]);
+            store(&tile[r][lanes], acc[r][1]);
+        }
+        for (size_t r = 0; r < mr; ++r)
+        {
+            T *row = c + r * ldc;
+            for (size_t j = 0; j < nr; ++j)
+                row[j] = accumulate ? row[j] + tile[r][j] : tile[r][j];
+        }
+    }
+};
+
+/// @brief Matrix product C = A * B for row-major float or double matrices
+/// @param m Rows of A and C
+/// @param n Columns of B and C
+/// @param k Columns of A and rows of B
+/// @param a First cell of A
+/// @param lda Row stride of A
+/// @param b First cell of B
+/// @param ldb Row stride of B
+/// @param c First cell of C, must not overlap A or B
+/// @param ldc Row stride of C
+template <typename T>
+void gemm(const size_t &m, const size_t &n, const size_t &k,
+          const T *a, const size_t &lda, const T *b, const size_t &ldb, T *c, const size_t &ldc)
+{
+    using K = GemmKernel<T>;
+
+    if (k == 0)
+    {
+        for (size_t i = 0; i < m; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+                c[i * ldc + j] = T{0};
+        }
+        return;
+    }
+
+    // Packing buffers are reused across calls on the same thread
+    thread_local std::vector<T> packedA, packedB;
+    packedA.resize(K::MC * K::KC);
+    packedB.resize(K::KC * K::NC);
+
+    for (size_t jc = 0; jc < n; jc += K::NC)
+    {
+        const size_t nc = n - jc < K::NC ? n - jc : K::NC;
+        for (size_t pc = 0; pc < k; pc += K::KC)
+        {
+            const size_t kc = k - pc < K::KC ? k - pc : K::KC;
+            K::packB(kc, nc, b + pc * ldb + jc, ldb, packedB.data());
+
+            for (size_t ic = 0; ic < m; ic += K::MC)
+            {
+                const size_t mc = m - ic < K::MC ? m - ic : K::MC;
+                K::packA(mc, kc, a + ic * lda + pc, lda, packedA.data());
+
+                for (size_t jr = 0; jr < nc; jr += K::NR)
+                {
+                    const size_t nr = nc - jr < K::NR ? nc - jr : K::NR;
+                    for (size_t ir = 0; ir < mc; ir += K::MR)
+                    {
+                        const size_t mr = mc - ir < K::MR ? mc - ir : K::MR;
+                        K::kernel(kc, packedA.data() + ir * kc, packedB.data() + jr * kc,
+                                  c + (ic + ir) * ldc + jc + jr, ldc, mr, nr, pc != 0);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdlib>
+#include <cassert>
+#include <vector>
+
+#include <include/dyn_matrix.hpp>
+#include <include/matrix.hpp>
+#include <include/matrix_view.hpp>
+#include <include/modular.hpp>
+#include <include/thread_pool.hpp>
+
+// Laplace expansion with memoized minors. Expanding along the first row, then
+// along the first row of each minor and so on, a minor is fixed by the set of
+// columns it keeps: the minor on the last k rows and columns S. There are 2^n
+// such sets, against the n! paths the plain recursion walks to reach them, so
+// the determinant comes out of one table of 2^n minors, filled by increasing
+// size in O(n * 2^n) operations:
+//
+//   minor(S) = sum over j in S of (-1)^(position of j in S) * a(n - |S|, j) * minor(S - {j})
+//
+// Only additions, subtractions and multiplications are used, so any commutative
+// ring works as the data type: integers, which can't divide exactly, BigInt,
+// residues modulo a composite number. Over a field, elimination is O(n^3) and
+// much faster; this is for rings elimination doesn't apply to.
+//
+// Minors of the same size don't depend on each other, so each size is filled in
+// parallel. Every chunk runs under the caller's thread-local state, so Modular
+// minors are taken modulo the caller's modulus, whichever thread computes them
+
+/// @brief Largest order memoizedLapLaceDeterminant accepts, its table holding 2^order minors
+constexpr size_t memoizedLapLaceMaximumOrder = 24;
+
+/// @brief Fewest column sets per parallel chunk
+constexpr size_t memoizedLapLaceGrain = 1 << 12;
+
+/// @brief Calculates determinant by Laplace expansion, memoizing every minor by its set of columns.
+/// Division-free, O(n * 2^n) time and O(2^n) memory
+/// @tparam T matrix data type, any commutative ring
+/// @param m Square view, of order at most memoizedLapLaceMaximumOrder
+/// @param pool Thread pool filling each size of minors
+/// @return Matrix's determinant
+template <typename T>
+T memoizedLapLaceDeterminant(const MatrixView<T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    assert((m.rows() == m.cols()) && "Determinant is defined only for square matrices");
+    assert((m.rows() <= memoizedLapLaceMaximumOrder) && "Matrix order too large for a table of minors");
+
+    // No data
+    const size_t n = m.rows();
+    if (n == 0)
+        return T{0};
+
+    // Minor on the last popcount(s) rows and the columns in bitmask s; the empty one is 1
+    const size_t full = (size_t{1} << n) - 1;
+    std::vector<T> minors(full + 1, T{0});
+    minors[0] = T{1};
+
+    const ThreadState<T> state;
+    for (size_t k = 1; k <= n; ++k)
+    {
+        const size_t row = n - k;
+        pool.parallelFor(1, full + 1, memoizedLapLaceGrain, [&](const size_t &s0, const size_t &s1)
+                         {
+            [[maybe_unused]] const auto scope = state.enter();
+            for (size_t s = s0; s < s1; ++s)
+            {
+                if ((size_t)__builtin_popcountll(s) != k)
+                    continue;
+
+                // Columns of s in increasing order, alternating sign
+                T det{0};
+                bool odd = false;
+                for (size_t bits = s; bits != 0; bits &= bits - 1, odd = !odd)
+                {
+                    const size_t j = __builtin_ctzll(bits);
+                    const T &a = m(row, j);
+                    if (a == T{0})
+                        continue;
+
+                    const T term = a * minors[s ^ (size_t{1} << j)];
+                    if (odd)
+                        det -= term;
+                    else
+                        det += term;
+                }
+                minors[s] = det;
+            } });
+    }
+
+    return minors[full];
+}
+
+/// @brief Calculates determinant by Laplace expansion, memoizing every minor by its set of columns
+/// @tparam T matrix data type, any commutative ring
+/// @param m Matrix
+/// @param pool Thread pool filling each size of minors
+/// @return Matrix's determinant
+template <size_t R, size_t C, typename T>
+T memoizedLapLaceDeterminant(const Matrix<R, C, T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    static_assert((R == C) && "Determinant is defined only for square matrices");
+    return memoizedLapLaceDeterminant(m.view(), pool);
+}
+
+/// @brief Calculates determinant by Laplace expansion, memoizing every minor by its set of columns
+/// @tparam T matrix data type, any commutative ring
+/// @param m Matrix
+/// @param pool Thread pool filling each size of minors
+/// @return Matrix's determinant
+template <typename T>
+T memoizedLapLaceDeterminant(const DynMatrix<T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    return memoizedLapLaceDeterminant(m.view(), pool);
+}
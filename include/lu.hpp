@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <type_traits>
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+#include <include/permutation.hpp>
+
+/// @brief LU factorization with partial pivoting, P * A = L * U. Computed once, it answers
+/// determinant, inverse and any number of solves without eliminating A again
+/// @tparam R Matrix order
+/// @tparam T Matrix data type
+template <size_t R, typename T>
+class LU
+{
+public:
+    /// @brief Factorizes a matrix. Floating types pivot on the largest magnitude in each column,
+    /// for stability; exact types pivot on the first nonzero cell, which keeps the arithmetic simplest
+    /// @param m Matrix
+    LU(const Matrix<R, R, T> &m);
+
+    /// @brief Whether the factorized matrix is singular
+    /// @return Whether some pivot column was null
+    bool isSingular() const;
+
+    /// @brief Determinant of the factorized matrix
+    /// @return Product of U's diagonal, with the permutation's sign
+    T determinant() const;
+
+    /// @brief Solves A * x = b
+    /// @param b Right-hand side
+    /// @return Solution x, or a null vector if A is singular
+    std::array<T, R> solve(const std::array<T, R> &b) const;
+
+    /// @brief Solves A * X = B, for every column of B at once
+    /// @param B Right-hand sides
+    /// @return Solution X, or a null matrix if A is singular
+    template <size_t C>
+    Matrix<R, C, T> solve(const Matrix<R, C, T> &B) const;
+
+    /// @brief Inverse of the factorized matrix
+    /// @return A's inverse, or a null matrix if A is singular
+    Matrix<R, R, T> inverse() const;
+
+    /// @brief Packed factors: U on and above the diagonal, L's multipliers below it
+    /// (L's unit diagonal is implicit)
+    const Matrix<R, R, T> &factors() const;
+
+    /// @brief Row permutation P: row i of P * A is row permutation()[i] of A
+    const Permutation<R> &permutation() const;
+
+private:
+    /// @brief Replaces B by X in L * U * X = P * B
+    template <size_t C>
+    void substitute(Matrix<R, C, T> &B) const;
+
+    Matrix<R, R, T> lu;
+    Permutation<R> perm;
+    bool singular = false;
+};
+
+template <size_t R, typename T>
+LU<R, T>::LU(const Matrix<R, R, T> &m) : lu{m}
+{
+    // Rows are addressed through the permutation while eliminating, and put in order once at the end
+    for (size_t c = 0; c < R; ++c)
+    {
+        size_t row = -1;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // Largest magnitude
+            T best = T{0};
+            for (size_t i = c; i < R; ++i)
+            {
+                const T mag = std::abs(lu.data[perm[i]][c]);
+                if (mag > best)
+                {
+                    best = mag;
+                    row = i;
+                }
+            }
+        }
+        else
+        {
+            // First nonzero
+            for (size_t i = c; i < R; ++i)
+            {
+                if (lu.data[perm[i]][c] != T{0})
+                {
+                    row = i;
+                    break;
+                }
+            }
+        }
+
+        if (row == -1UL)
+        {
+            // Null column, U has a zero on its diagonal
+            singular = true;
+            break;
+        }
+
+        perm.swap(row, c);
+        const T *pivot = lu.data[perm[c]];
+
+        // Store each row's multiplier where its zero would be, and update the trailing submatrix
+        const T inv = T{1} / pivot[c];
+        for (size_t i = c + 1; i < R; ++i)
+        {
+            T *cells = lu.data[perm[i]];
+            if (cells[c] == T{0})
+                continue;
+
+            const T l = cells[c] * inv;
+            cells[c] = l;
+            for (size_t j = c + 1; j < R; ++j)
+                multiplyAdd(cells[j], -l, pivot[j]);
+        }
+    }
+
+    lu = perm.apply(lu);
+}
+
+template <size_t R, typename T>
+bool LU<R, T>::isSingular() const
+{
+    return singular;
+}
+
+template <size_t R, typename T>
+T LU<R, T>::determinant() const
+{
+    if (singular)
+        return T{0};
+
+    T det = perm.template sign<T>();
+    for (size_t i = 0; i < R; ++i)
+        det *= lu.data[i][i];
+
+    return det;
+}
+
+template <size_t R, typename T>
+template <size_t C>
+void LU<R, T>::substitute(Matrix<R, C, T> &B) const
+{
+    // Permute rows, then forward substitution with L
+    Matrix<R, C, T> y{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+            y.data[i][j] = B.data[perm[i]][j];
+
+        for (size_t k = 0; k < i; ++k)
+        {
+            const T l = lu.data[i][k];
+            if (l == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(y.data[i][j], -l, y.data[k][j]);
+        }
+    }
+
+    // Backward substitution with U
+    for (size_t i = R; i-- > 0;)
+    {
+        for (size_t k = i + 1; k < R; ++k)
+        {
+            const T u = lu.data[i][k];
+            if (u == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(y.data[i][j], -u, y.data[k][j]);
+        }
+
+        y.multiplyRow(i, T{1} / lu.data[i][i]);
+    }
+
+    B = y;
+}
+
+template <size_t R, typename T>
+std::array<T, R> LU<R, T>::solve(const std::array<T, R> &b) const
+{
+    Matrix<R, 1, T> x{};
+    for (size_t i = 0; i < R; ++i)
+        x.data[i][0] = b[i];
+
+    x = solve(x);
+
+    std::array<T, R> res{};
+    for (size_t i = 0; i < R; ++i)
+        res[i] = x.data[i][0];
+
+    return res;
+}
+
+template <size_t R, typename T>
+template <size_t C>
+Matrix<R, C, T> LU<R, T>::solve(const Matrix<R, C, T> &B) const
+{
+    if (singular)
+    {
+        printf("No solution: matrix is singular\n\n");
+        return Matrix<R, C, T>();
+    }
+
+    Matrix<R, C, T> X{B};
+    substitute(X);
+    return X;
+}
+
+template <size_t R, typename T>
+Matrix<R, R, T> LU<R, T>::inverse() const
+{
+    if (singular)
+    {
+        printf("No inverse: matrix is singular\n\n");
+        return Matrix<R, R, T>();
+    }
+
+    return solve(Matrix<R, R, T>::identity());
+}
+
+template <size_t R, typename T>
+const Matrix<R, R, T> &LU<R, T>::factors() const
+{
+    return lu;
+}
+
+template <size_t R, typename T>
+const Permutation<R> &LU<R, T>::permutation() const
+{
+    return perm;
+}
@@ -4,6 +4,16 @@
 #include <iostream>
 #include <cassert>
 #include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <include/cofactor.hpp>
+#include <include/fraction.hpp>
+#include <include/gemm.hpp>
+#include <include/permutation.hpp>
+#include <include/simd.hpp>
+#include <include/unroll.hpp>
 
 /// @brief Matrix class
 /// @tparam T Matrix data type
@@ -13,12 +23,70 @@ class Matrix;
 template <size_t R, size_t C, typename T>
 using array2d = std::array<std::array<T, C>, R>;
 
+template <typename E>
+class BasicMatrixView;
+
+/// @brief Accumulates a product into a cell: acc += a * b
+/// @tparam T matrix data type
+/// @param acc Accumulator
+/// @param a First factor
+/// @param b Second factor
+template <typename T>
+constexpr void multiplyAdd(T &acc, const T &a, const T &b)
+{
+    acc += a * b;
+}
+
+/// @brief Accumulates a fraction product with a single reduction
+/// @param acc Accumulator
+/// @param a First factor
+/// @param b Second factor
+constexpr void multiplyAdd(Fraction &acc, const Fraction &a, const Fraction &b)
+{
+    acc.addProduct(a, b);
+}
+
 /// @brief Right side product of scalar and matrix
 /// @param s Scalar value
 /// @param m Matrix
 /// @return Result of product
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> operator*(const T &s, const Matrix<R, C, T> &m);
+constexpr Matrix<R, C, T> operator*(const T &s, const Matrix<R, C, T> &m);
+
+/// @brief Right side product of scalar and a temporary matrix, reusing its cells
+/// @param s Scalar value
+/// @param m Matrix
+/// @return Result of product
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator*(const T &s, Matrix<R, C, T> &&m);
+
+/// @brief Addition of a matrix and a temporary matrix, reusing the temporary's cells
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of addition
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator+(const Matrix<R, C, T> &m0, Matrix<R, C, T> &&m1);
+
+/// @brief Addition of 2 temporary matrices, reusing the left one's cells
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of addition
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator+(Matrix<R, C, T> &&m0, Matrix<R, C, T> &&m1);
+
+/// @brief Difference of a matrix and a temporary matrix, reusing the temporary's cells
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of subtraction
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator-(const Matrix<R, C, T> &m0, Matrix<R, C, T> &&m1);
+
+/// @brief Difference of 2 temporary matrices, reusing the left one's cells
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of subtraction
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator-(Matrix<R, C, T> &&m0, Matrix<R, C, T> &&m1);
 
 /// @brief Matrix-matrix multiplication
 /// @tparam R Left matrix's rows, also resulting matrix's row
@@ -29,7 +97,7 @@ Matrix<R, C, T> operator*(const T &s, const Matrix<R, C, T> &m);
 /// @param m1 Right matrix
 /// @return Result of matrix product
 template <size_t R, size_t M, size_t C, typename T>
-Matrix<R, C, T> operator*(const Matrix<R, M, T> &m0, const Matrix<M, C, T> &m1);
+constexpr Matrix<R, C, T> operator*(const Matrix<R, M, T> &m0, const Matrix<M, C, T> &m1);
 
 /// @brief Calculates matrix determinant by Laplace method
 /// @tparam T matrix data type
@@ -38,13 +106,74 @@ Matrix<R, C, T> operator*(const Matrix<R, M, T> &m0, const Matrix<M, C, T> &m1);
 template <size_t R, size_t C, typename T>
 T lapLaceDeterminant(const Matrix<R, C, T> &m);
 
+/// @brief Calculates determinant of a minor by Laplace method, without copying it
+/// @tparam T matrix data type
+/// @param m View of the minor's rows
+/// @param cols Minor's columns in m, one per row of m, followed by room for the lists of
+/// the smaller minors, m.rows() * (m.rows() + 1) / 2 indices in all
+/// @return Minor's determinant
+template <typename T>
+T lapLaceDeterminant(const BasicMatrixView<const T> &m, size_t *cols);
+
+/// @brief Calculates matrix determinant by Gaussian elimination
+/// @tparam T matrix data type
+/// @param m Matrix
+/// @return Matrix's determinant
+template <size_t R, size_t C, typename T>
+T rowReductionDeterminant(const Matrix<R, C, T> &m);
+
+/// @brief Calculates matrix inverse by Gauss-Jordan elimination
+/// @tparam T matrix data type
+/// @param m Matrix
+/// @return Matrix's inverse, or a null matrix if it has no inverse
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> gaussJordanInverse(const Matrix<R, C, T> &m);
+
+/// @brief Calculates determinant of a 2x2, 3x3 or 4x4 matrix by its cofactor closed form
+/// @tparam T matrix data type
+/// @param m Matrix
+/// @return Matrix's determinant
+template <size_t R, size_t C, typename T>
+T closedFormDeterminant(const Matrix<R, C, T> &m);
+
+/// @brief Calculates inverse of a 2x2, 3x3 or 4x4 matrix as its adjugate divided by its determinant
+/// @tparam T matrix data type
+/// @param m Matrix
+/// @return Matrix's inverse, or a null matrix if it has no inverse
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> closedFormInverse(const Matrix<R, C, T> &m);
+
+/// @brief Solves A * X = B by Gaussian elimination on the augmented matrix [A | B], then back substitution
+/// @tparam T matrix data type
+/// @param A Coefficient matrix
+/// @param B Right-hand sides, one per column
+/// @return Solution X, or a null matrix if A is singular
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> gaussianSolve(const Matrix<R, R, T> &A, const Matrix<R, C, T> &B);
+
+/// @brief Solves A * X = B without forming A's inverse
+/// @tparam T matrix data type
+/// @param A Coefficient matrix
+/// @param B Right-hand sides, one per column
+/// @return Solution X, or a null matrix if A is singular
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> solve(const Matrix<R, R, T> &A, const Matrix<R, C, T> &B);
+
+/// @brief Solves A * x = b without forming A's inverse
+/// @tparam T matrix data type
+/// @param A Coefficient matrix
+/// @param b Right-hand side
+/// @return Solution x, or a null vector if A is singular
+template <size_t R, typename T>
+std::array<T, R> solve(const Matrix<R, R, T> &A, const std::array<T, R> &b);
+
 template <size_t R, size_t C, typename T>
 class Matrix
 {
 public:
     /// @brief Constructor with initial cell value
     /// @param v Optional initial value
-    Matrix(const T &v = T{0});
+    constexpr Matrix(const T &v = T{0});
 
     /// @brief Constructor with matrix data
     /// @param r Number of R
@@ -53,18 +182,33 @@ public:
     // Matrix(T data[R][C]);
 
     /// @brief Constructor from brace initializer list
-    Matrix(const array2d<R, C, T> &data);
+    constexpr Matrix(const array2d<R, C, T> &data);
 
     /// @brief Copy constructor
     /// @param m Matrix to be copied
-    Matrix(const Matrix<R, C, T> &m);
+    Matrix(const Matrix<R, C, T> &m) = default;
+
+    /// @brief Move constructor, moves every cell
+    /// @param m Matrix to be moved
+    Matrix(Matrix<R, C, T> &&m) = default;
+
+    /// @brief Constructor evaluating a lazy expression (see include/matrix_expr.hpp)
+    /// @param e Expression
+    template <typename E, typename = typename E::isMatrixExpr>
+    Matrix(const E &e);
 
     /// @brief Destructor
-    ~Matrix();
+    ~Matrix() = default;
 
     /// @brief Transpose of this matrix
     /// @return This matrix transposed
-    Matrix<C, R, T> transpose();
+    constexpr Matrix<C, R, T> transpose() const;
+
+    /// @brief Read-only view of all cells, for the view* kernels
+    BasicMatrixView<const T> view() const;
+
+    /// @brief Writable view of all cells, for the view* kernels
+    BasicMatrixView<T> span();
 
     /// @brief Calculate this matrix's determinant
     /// @return The calculated determinant
@@ -80,70 +224,105 @@ public:
     /// @brief Copy assign operator
     /// @param m Matrix to be copied
     /// @return Copied matrix
-    Matrix<R, C, T> &operator=(const Matrix<R, C, T> &m);
+    Matrix<R, C, T> &operator=(const Matrix<R, C, T> &m) = default;
+
+    /// @brief Move assign operator, moves every cell
+    /// @param m Matrix to be moved
+    /// @return Moved matrix
+    Matrix<R, C, T> &operator=(Matrix<R, C, T> &&m) = default;
+
+    /// @brief Evaluates a lazy expression into this matrix in a single pass (see include/matrix_expr.hpp)
+    /// @param e Expression
+    /// @return Evaluated matrix
+    template <typename E, typename = typename E::isMatrixExpr>
+    Matrix<R, C, T> &operator=(const E &e);
 
     /// @brief Equal check operator
     /// @param m Other matrix
     /// @return Whether 2 matrices have the same data
-    bool operator==(const Matrix<R, C, T> &m) const;
+    constexpr bool operator==(const Matrix<R, C, T> &m) const;
 
     /// @brief Not equal check operator
     /// @param m Other matrix
     /// @return Whether 2 matrices have different data
-    bool operator!=(const Matrix<R, C, T> &m) const;
+    constexpr bool operator!=(const Matrix<R, C, T> &m) const;
 
     /// @brief Addition of 2 matrices
     /// @param m Other matrix
     /// @return Result of addition
-    Matrix<R, C, T> operator+(const Matrix<R, C, T> &m) const;
+    constexpr Matrix<R, C, T> operator+(const Matrix<R, C, T> &m) const &;
+
+    /// @brief Addition of 2 matrices, reusing this temporary's cells
+    /// @param m Other matrix
+    /// @return Result of addition
+    constexpr Matrix<R, C, T> operator+(const Matrix<R, C, T> &m) &&;
 
     /// @brief Addition of 2 matrices, then assign
     /// @param m Other matrix
     /// @return Result of addition
-    Matrix<R, C, T> &operator+=(const Matrix<R, C, T> &m);
+    constexpr Matrix<R, C, T> &operator+=(const Matrix<R, C, T> &m);
 
     /// @brief Difference of 2 matrices
     /// @param m Other matrix
     /// @return Result of subtraction
-    Matrix<R, C, T> operator-(const Matrix<R, C, T> &m) const;
+    constexpr Matrix<R, C, T> operator-(const Matrix<R, C, T> &m) const &;
+
+    /// @brief Difference of 2 matrices, reusing this temporary's cells
+    /// @param m Other matrix
+    /// @return Result of subtraction
+    constexpr Matrix<R, C, T> operator-(const Matrix<R, C, T> &m) &&;
 
     /// @brief Difference of 2 matrices, then assign
     /// @param m Other matrix
     /// @return Result of subtraction
-    Matrix<R, C, T> &operator-=(const Matrix<R, C, T> &m);
+    constexpr Matrix<R, C, T> &operator-=(const Matrix<R, C, T> &m);
 
     /// @brief Negative matrix operator
     /// @return This matrix, with all cell's signs flipped
-    Matrix<R, C, T> operator-() const;
+    constexpr Matrix<R, C, T> operator-() const &;
+
+    /// @brief Negative matrix operator, reusing this temporary's cells
+    /// @return This matrix, with all cell's signs flipped
+    constexpr Matrix<R, C, T> operator-() &&;
 
     /// @brief Product of 2 matrices, then assign
     /// @param m Other matrix
     /// @return Result of product
-    Matrix<R, C, T> &operator*=(const Matrix<R, C, T> &m);
+    constexpr Matrix<R, C, T> &operator*=(const Matrix<R, C, T> &m);
 
     /// @brief Product of scalar and matrix
     /// @param s Scalar value
     /// @return Result of product
-    Matrix<R, C, T> operator*(const T &s) const;
+    constexpr Matrix<R, C, T> operator*(const T &s) const &;
+
+    /// @brief Product of scalar and matrix, reusing this temporary's cells
+    /// @param s Scalar value
+    /// @return Result of product
+    constexpr Matrix<R, C, T> operator*(const T &s) &&;
 
     /// @brief Product of scalar and matrix, then assign
     /// @param s Scalar value
     /// @return Result of product
-    Matrix<R, C, T> &operator*=(const T &s);
+    constexpr Matrix<R, C, T> &operator*=(const T &s);
 
     /// @brief Division of matrix by scalar
     /// @param s Scalar value
     /// @return Result of division
-    Matrix<R, C, T> operator/(const T &s) const;
+    constexpr Matrix<R, C, T> operator/(const T &s) const &;
+
+    /// @brief Division of matrix by scalar, reusing this temporary's cells
+    /// @param s Scalar value
+    /// @return Result of division
+    constexpr Matrix<R, C, T> operator/(const T &s) &&;
 
     /// @brief Division of matrix by scalar, then assign
     /// @param s Scalar value
     /// @return Result of division
-    Matrix<R, C, T> &operator/=(const T &s);
+    constexpr Matrix<R, C, T> &operator/=(const T &s);
 
     /// @brief Identity matrix
     /// @return Identity matrix with given order
-    static Matrix<R, C, T> identity();
+    static constexpr Matrix<R, C, T> identity();
 
     /// @brief Elementary operation - swap two rows
     /// @param r0 first row
@@ -173,7 +352,7 @@ private:
 };
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T>::Matrix(const T &v)
+constexpr Matrix<R, C, T>::Matrix(const T &v)
 {
     for (size_t i = 0; i < R; ++i)
     {
@@ -185,7 +364,7 @@ Matrix<R, C, T>::Matrix(const T &v)
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T>::Matrix(const array2d<R, C, T> &data)
+constexpr Matrix<R, C, T>::Matrix(const array2d<R, C, T> &data)
 {
     for (size_t i = 0; i < R; ++i)
     {
@@ -197,24 +376,22 @@ Matrix<R, C, T>::Matrix(const array2d<R, C, T> &data)
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T>::Matrix(const Matrix<R, C, T> &m)
+template <typename E, typename>
+Matrix<R, C, T>::Matrix(const E &e)
 {
-    for (size_t i = 0; i < R; ++i)
-    {
-        for (size_t j = 0; j < C; ++j)
-        {
-            data[i][j] = m.data[i][j];
-        }
-    }
+    evaluateInto(*this, e);
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T>::~Matrix()
+template <typename E, typename>
+Matrix<R, C, T> &Matrix<R, C, T>::operator=(const E &e)
 {
+    evaluateInto(*this, e);
+    return *this;
 }
 
 template <size_t R, size_t C, class T>
-Matrix<R, C, T> Matrix<R, C, T>::identity()
+constexpr Matrix<R, C, T> Matrix<R, C, T>::identity()
 {
     static_assert(R == C, "Identity matrix is only defined for square orders");
 
@@ -228,8 +405,16 @@ Matrix<R, C, T> Matrix<R, C, T>::identity()
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<C, R, T> Matrix<R, C, T>::transpose()
+constexpr Matrix<C, R, T> Matrix<R, C, T>::transpose() const
 {
+    if constexpr (R * C <= unrollMaximumCells)
+    {
+        Matrix<C, R, T> m{};
+        unroll<R * C>([&](auto k)
+                      { m.data[k % C][k / C] = data[k / C][k % C]; });
+        return m;
+    }
+
     Matrix<C, R, T> m{};
 
     for (size_t j = 0; j < C; ++j)
@@ -243,6 +428,18 @@ Matrix<C, R, T> Matrix<R, C, T>::transpose()
     return m;
 }
 
+template <size_t R, size_t C, typename T>
+BasicMatrixView<const T> Matrix<R, C, T>::view() const
+{
+    return BasicMatrixView<const T>{data[0], R, C, C};
+}
+
+template <size_t R, size_t C, typename T>
+BasicMatrixView<T> Matrix<R, C, T>::span()
+{
+    return BasicMatrixView<T>{data[0], R, C, C};
+}
+
 template <size_t R, size_t C, typename T>
 T lapLaceDeterminant(const Matrix<R, C, T> &m)
 {
@@ -254,36 +451,57 @@ T lapLaceDeterminant(const Matrix<R, C, T> &m)
         return 0;
     }
 
+    // Column lists of every level, R + (R - 1) + ... + 1 indices
+    size_t cols[R * (R + 1) / 2];
+    for (size_t j = 0; j < R; ++j)
+        cols[j] = j;
+
+    return lapLaceDeterminant(m.view(), cols);
+}
+
+template <typename T>
+T lapLaceDeterminant(const BasicMatrixView<const T> &m, size_t *cols)
+{
+    // Each minor is the view's rows below the first, restricted to the columns listed
+    // in cols[0, n); the list for the next level is written right after it
+    const size_t n = m.rows();
+    if (n == 1)
+        return m(0, cols[0]);
+
+    // Most calls are small minors, expanded in closed form
+    if (n == 2)
+        return m(0, cols[0]) * m(1, cols[1]) - m(0, cols[1]) * m(1, cols[0]);
+    if (n == 3)
+    {
+        const size_t c0 = cols[0], c1 = cols[1], c2 = cols[2];
+        return m(0, c0) * (m(1, c1) * m(2, c2) - m(1, c2) * m(2, c1)) -
+               m(0, c1) * (m(1, c0) * m(2, c2) - m(1, c2) * m(2, c0)) +
+               m(0, c2) * (m(1, c0) * m(2, c1) - m(1, c1) * m(2, c0));
+    }
+
+    const BasicMatrixView<const T> rows = m.block(1, 0, n - 1, m.cols());
+    size_t *minor = cols + n;
+    for (size_t k = 1; k < n; ++k)
+        minor[k - 1] = cols[k];
+
     // Laplace method
     T det = T{0};
-    for (size_t i = 0; i < R; ++i)
+    for (size_t i = 0; i < n; ++i)
     {
-        if (m.data[0][i] == 0)
-            continue;
+        // The minor of column i drops cols[i]: put back the one dropped last time
+        if (i > 0)
+            minor[i - 1] = cols[i - 1];
 
-        // Construct new matrix
-        Matrix<R - 1, R - 1, T> n{};
-        for (size_t j = 0; j < R - 1; ++j)
-        {
-            for (size_t k = 0; k < R - 1; ++k)
-            {
-                size_t col = k < i ? k : k + 1;
-                n.data[j][k] = m.data[j + 1][col];
-            }
-        }
+        const T &a = m(0, cols[i]);
+        if (a == T{0})
+            continue;
 
-        det += T{i & 1 ? -1 : 1} * m.data[0][i] * lapLaceDeterminant(n);
+        det += (i & 1 ? -a : a) * lapLaceDeterminant(rows, minor);
     }
 
     return det;
 }
 
-template <typename T>
-T lapLaceDeterminant(const Matrix<1, 1, T> &m)
-{
-    return m.data[0][0];
-}
-
 template <size_t R, size_t C, typename T>
 T rowReductionDeterminant(const Matrix<R, C, T> &m)
 {
@@ -292,6 +510,9 @@ T rowReductionDeterminant(const Matrix<R, C, T> &m)
     // Create a copy of this matrix
     Matrix<R, C, T> tmp{m};
 
+    // Rows are addressed through a permutation, so swaps don't move any cell
+    Permutation<R> perm;
+
     // Save determinant scale
     T scale = T{1};
 
@@ -303,7 +524,7 @@ T rowReductionDeterminant(const Matrix<R, C, T> &m)
         size_t row = -1;
         for (size_t i = c; i < R; ++i)
         {
-            if (tmp.data[i][c] != T{0})
+            if (tmp.data[perm[i]][c] != T{0})
             {
                 row = i;
                 break;
@@ -317,50 +538,317 @@ T rowReductionDeterminant(const Matrix<R, C, T> &m)
         }
 
         // If first nonzero row is not the same as current working column, swap rows
-        if (row != c)
-        {
-            tmp.swapRows(row, c);
-            // Multiply scale by -1 when swapping rows
-            scale *= T{-1};
-        }
+        perm.swap(row, c);
+        const size_t pivot = perm[c];
 
         // Make sure row[c] is 1
-        T rowScale = tmp.data[c][c];
+        T rowScale = tmp.data[pivot][c];
         if (rowScale != T{1})
         {
             // Multiply by inverse
             T mult = T{1} / rowScale;
-            tmp.multiplyRow(c, mult);
+            tmp.multiplyRow(pivot, mult);
             // Change determinant scale too
             scale *= rowScale;
         }
 
-
         // Make sure all other rows have zeros on this column
         for (size_t i = c + 1; i < R; ++i)
         {
             // If already zero, skip
-            T elem = tmp.data[i][c];
+            T elem = tmp.data[perm[i]][c];
             if (elem == T{0})
                 continue;
 
             // Add the opposite
-            tmp.addScaledRow(i, c, -elem);
+            tmp.addScaledRow(perm[i], pivot, -elem);
+        }
+    }
+
+    // Every swap flips the determinant's sign
+    return scale * perm.template sign<T>();
+}
+
+/// @brief Checks whether every cell of a fraction matrix is an integer
+/// @param m Matrix
+/// @return Whether all cells have denominator 1
+template <size_t R, size_t C>
+bool hasIntegerEntries(const Matrix<R, C, Fraction> &m)
+{
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            if (m.data[i][j].denominator != 1)
+                return false;
         }
     }
 
-    return scale;
+    return true;
+}
+
+/// @brief One fraction-free elimination step: (p * a - b * c) / prev, where the division is exact
+/// @param p Current pivot
+/// @param a Cell being updated
+/// @param b Cell on pivot column of the updated row
+/// @param c Cell on pivot row of the updated column
+/// @param prev Previous pivot
+/// @return Updated cell
+/// @throws std::overflow_error if the updated cell, a minor of the matrix, doesn't fit in 64 bits
+inline int64_t bareissStep(const int64_t &p, const int64_t &a, const int64_t &b, const int64_t &c, const int64_t &prev)
+{
+    // Products may exceed 64 bits, but the quotient is a minor of the matrix
+    __int128 num;
+    if (__builtin_sub_overflow((__int128)p * a, (__int128)b * c, &num))
+        throw std::overflow_error("Bareiss minor does not fit in 64 bits");
+    assert((num % prev == 0) && "Bareiss division must be exact");
+
+    const __int128 res = num / prev;
+    if (res < INT64_MIN || res > INT64_MAX)
+        throw std::overflow_error("Bareiss minor does not fit in 64 bits");
+    return (int64_t)res;
+}
+
+/// @brief Fraction-free elimination on rows of integers, shared by every Bareiss routine. Pivot
+/// columns are cleared below the pivot, or above and below it for Gauss-Jordan; columns left of
+/// the pivot are zero except for earlier pivots, which are never read again, so they are skipped.
+/// Row swaps exchange row pointers only
+/// @param rows Row pointers, reordered by the pivot swaps
+/// @param n Number of rows, and of pivot columns
+/// @param width Number of columns
+/// @param jordan Whether to clear above the pivots as well
+/// @param prev Receives the last pivot: the determinant, up to sign
+/// @param sign Receives -1 if an odd number of rows were swapped, 1 otherwise
+/// @return First null pivot column, or n if every pivot was nonzero
+/// @throws std::overflow_error if a minor doesn't fit in 64 bits
+inline size_t bareissEliminate(int64_t **rows, const size_t &n, const size_t &width, const bool &jordan, int64_t &prev, int64_t &sign)
+{
+    prev = 1;
+    sign = 1;
+    for (size_t c = 0; c < n; ++c)
+    {
+        // Find first nonzero row
+        size_t row = c;
+        while (row < n && rows[row][c] == 0)
+            ++row;
+        if (row == n)
+            return c;
+
+        // Swapping rows flips the determinant sign
+        if (row != c)
+        {
+            std::swap(rows[row], rows[c]);
+            sign = -sign;
+        }
+
+        // Every updated cell becomes a minor of the original matrix
+        const int64_t *pivotRow = rows[c];
+        for (size_t i = jordan ? 0 : c + 1; i < n; ++i)
+        {
+            if (i == c)
+                continue;
+
+            int64_t *cur = rows[i];
+            for (size_t j = c + 1; j < width; ++j)
+            {
+                cur[j] = bareissStep(pivotRow[c], cur[j], cur[c], pivotRow[j], prev);
+            }
+            cur[c] = 0;
+        }
+        prev = pivotRow[c];
+    }
+
+    return n;
+}
+
+/// @brief Calculates determinant of an integer fraction matrix by Bareiss fraction-free elimination.
+/// Works only on numerators, so no GCD is ever evaluated
+/// @param m Matrix, all cells must have denominator 1
+/// @return Matrix's determinant
+/// @throws std::overflow_error if a minor doesn't fit in 64 bits
+template <size_t R, size_t C>
+Fraction bareissDeterminant(const Matrix<R, C, Fraction> &m)
+{
+    static_assert((R == C) && "Determinant is defined only for square matrices");
+    assert(hasIntegerEntries(m) && "Bareiss elimination requires integer cells");
+
+    if (R == 0)
+    {
+        return 0;
+    }
+
+    int64_t a[R][C];
+    int64_t *rows[R];
+    for (size_t i = 0; i < R; ++i)
+    {
+        rows[i] = a[i];
+        for (size_t j = 0; j < C; ++j)
+        {
+            a[i][j] = m.data[i][j].numerator;
+        }
+    }
+
+    int64_t prev, sign;
+    if (bareissEliminate(rows, R, C, false, prev, sign) != R)
+    {
+        // Entire column is zero
+        return 0;
+    }
+
+    return Fraction{sign * prev};
+}
+
+/// @brief Calculates inverse of an integer fraction matrix by fraction-free Gauss-Jordan elimination.
+/// Left side of the augmented matrix ends as det * I, so the inverse is the right side divided by det
+/// @param m Matrix, all cells must have denominator 1
+/// @return Matrix's inverse, or a null matrix if it has no inverse
+/// @throws std::overflow_error if a minor doesn't fit in 64 bits
+template <size_t R, size_t C>
+Matrix<R, C, Fraction> bareissInverse(const Matrix<R, C, Fraction> &m)
+{
+    static_assert((R == C) && "Inverse of matrix is defined only for square matrices");
+    assert(hasIntegerEntries(m) && "Bareiss elimination requires integer cells");
+
+    // Left side is current matrix, right side is identity
+    int64_t a[R][2 * C];
+    int64_t *rows[R];
+    for (size_t i = 0; i < R; ++i)
+    {
+        rows[i] = a[i];
+        for (size_t j = 0; j < C; ++j)
+        {
+            a[i][j] = m.data[i][j].numerator;
+            a[i][j + C] = i == j ? 1 : 0;
+        }
+    }
+
+    int64_t prev, sign;
+    const size_t null = bareissEliminate(rows, R, 2 * C, true, prev, sign);
+    if (null != R)
+    {
+        // Entire column is zero, can't reach identity
+        printf("No inverse: reached a state where column %ld is null\n\n", null);
+        return Matrix<R, C, Fraction>();
+    }
+
+    // Last pivot is the determinant (up to sign), shared by the whole left diagonal
+    Matrix<R, C, Fraction> res{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            res.data[i][j] = Fraction{rows[i][j + C], prev};
+            res.data[i][j].reduce();
+        }
+    }
+
+    return res;
+}
+
+/// @brief Solves A * X = B for an integer fraction system by fraction-free Gauss-Jordan elimination on [A | B].
+/// Left side ends as det * I, so X is the right side divided by det
+/// @param A Coefficient matrix, all cells must have denominator 1
+/// @param B Right-hand sides, all cells must have denominator 1
+/// @return Solution X, or a null matrix if A is singular
+/// @throws std::overflow_error if a minor doesn't fit in 64 bits
+template <size_t R, size_t C>
+Matrix<R, C, Fraction> bareissSolve(const Matrix<R, R, Fraction> &A, const Matrix<R, C, Fraction> &B)
+{
+    assert(hasIntegerEntries(A) && hasIntegerEntries(B) && "Bareiss elimination requires integer cells");
+
+    int64_t a[R][R + C];
+    int64_t *rows[R];
+    for (size_t i = 0; i < R; ++i)
+    {
+        rows[i] = a[i];
+        for (size_t j = 0; j < R; ++j)
+        {
+            a[i][j] = A.data[i][j].numerator;
+        }
+        for (size_t j = 0; j < C; ++j)
+        {
+            a[i][j + R] = B.data[i][j].numerator;
+        }
+    }
+
+    int64_t prev, sign;
+    const size_t null = bareissEliminate(rows, R, R + C, true, prev, sign);
+    if (null != R)
+    {
+        printf("No solution: reached a state where column %ld is null\n\n", null);
+        return Matrix<R, C, Fraction>();
+    }
+
+    Matrix<R, C, Fraction> res{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            res.data[i][j] = Fraction{rows[i][j + R], prev};
+            res.data[i][j].reduce();
+        }
+    }
+
+    return res;
 }
 
 template <size_t R, size_t C, typename T>
 T Matrix<R, C, T>::determinant()
 {
+    // Small orders of machine numbers have straight-line cofactor formulas. Fractions keep
+    // eliminating, every cofactor product would cost a reduction
+    if constexpr (std::is_arithmetic_v<T> && R == C && R >= 2 && R <= 4)
+        return closedFormDeterminant(*this);
+
+    // Integer fraction matrices can skip every intermediate reduction. Minors may outgrow
+    // 64 bits where reduced fractions don't, so those fall back on checked elimination
+    if constexpr (std::is_same_v<T, Fraction>)
+    {
+        if (hasIntegerEntries(*this))
+        {
+            try
+            {
+                return bareissDeterminant(*this);
+            }
+            catch (const std::overflow_error &)
+            {
+            }
+        }
+    }
+
     // return lapLaceDeterminant(*this);
     return rowReductionDeterminant(*this);
 }
 
 template <size_t R, size_t C, typename T>
 Matrix<R, C, T> Matrix<R, C, T>::inverse()
+{
+    // Small orders of machine numbers have straight-line cofactor formulas. Fractions keep
+    // eliminating, every cofactor product would cost a reduction
+    if constexpr (std::is_arithmetic_v<T> && R == C && R >= 2 && R <= 4)
+        return closedFormInverse(*this);
+
+    // Integer fraction matrices can skip every intermediate reduction. Minors may outgrow
+    // 64 bits where reduced fractions don't, so those fall back on checked elimination
+    if constexpr (std::is_same_v<T, Fraction>)
+    {
+        if (hasIntegerEntries(*this))
+        {
+            try
+            {
+                return bareissInverse(*this);
+            }
+            catch (const std::overflow_error &)
+            {
+            }
+        }
+    }
+
+    return gaussJordanInverse(*this);
+}
+
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> gaussJordanInverse(const Matrix<R, C, T> &m)
 {
     static_assert((R == C) && "Inverse of matrix is defined only for square matrices");
 
@@ -373,7 +861,7 @@ Matrix<R, C, T> Matrix<R, C, T>::inverse()
         {
             if (j < C)
             {
-                inv.data[i][j] = data[i][j];
+                inv.data[i][j] = m.data[i][j];
             }
             else
             {
@@ -382,6 +870,9 @@ Matrix<R, C, T> Matrix<R, C, T>::inverse()
         }
     }
 
+    // Rows are addressed through a permutation, so swaps don't move any cell
+    Permutation<R> perm;
+
     // Perform elementary operations based on current working column
     // until left side is an identity matrix
     for (size_t c = 0; c < C; ++c)
@@ -390,7 +881,7 @@ Matrix<R, C, T> Matrix<R, C, T>::inverse()
         size_t row = -1;
         for (size_t i = c; i < R; ++i)
         {
-            if (inv.data[i][c] != T{0})
+            if (inv.data[perm[i]][c] != T{0})
             {
                 row = i;
                 break;
@@ -404,25 +895,23 @@ Matrix<R, C, T> Matrix<R, C, T>::inverse()
         }
 
         // If first nonzero row is not the same as current working column, swap rows
-        if (row != c)
-        {
-            inv.swapRows(row, c);
-        }
+        perm.swap(row, c);
+        const size_t pivot = perm[c];
 
         // Make sure row[c] is 1
-        T elem = inv.data[c][c];
+        T elem = inv.data[pivot][c];
         if (elem != T{1})
         {
             // Multiply by inverse
             T mult = T{1} / elem;
-            inv.multiplyRow(c, mult);
+            inv.multiplyRow(pivot, mult);
         }
 
-        // Make sure all other rows have zeros on this column
+        // Make sure all other rows have zeros on this column, their order doesn't matter here
         for (size_t i = 0; i < R; ++i)
         {
             // Don't change current row
-            if (i == c)
+            if (i == pivot)
                 continue;
 
             // If already zero, skip
@@ -431,17 +920,17 @@ Matrix<R, C, T> Matrix<R, C, T>::inverse()
                 continue;
 
             // Add the opposite
-            inv.addScaledRow(i, c, -elem);
+            inv.addScaledRow(i, pivot, -elem);
         }
     }
 
-    // Create matrix using only right side of result
+    // Create matrix using only right side of result, applying the permutation once
     Matrix<R, C, T> res{};
     for (size_t i = 0; i < R; ++i)
     {
         for (size_t j = 0; j < C; ++j)
         {
-            res.data[i][j] = inv.data[i][j + C];
+            res.data[i][j] = inv.data[perm[i]][j + C];
         }
     }
 
@@ -449,43 +938,220 @@ Matrix<R, C, T> Matrix<R, C, T>::inverse()
 }
 
 template <size_t R, size_t C, typename T>
-std::ostream &operator<<(std::ostream &os, const Matrix<R, C, T> &m)
+T closedFormDeterminant(const Matrix<R, C, T> &m)
 {
+    static_assert((R == C) && "Determinant is defined only for square matrices");
+
+    T det;
+    cofactorDeterminant<R>(m.data, det);
+    return det;
+}
+
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> closedFormInverse(const Matrix<R, C, T> &m)
+{
+    static_assert((R == C) && "Inverse of matrix is defined only for square matrices");
+
+    Matrix<R, C, T> res{};
+    T det;
+    cofactorAdjugate<R>(m.data, res.data, det);
+    if (det == T{0})
+    {
+        printf("No inverse: determinant is null\n\n");
+        return Matrix<R, C, T>();
+    }
+
+    // One division, then a product per cell
+    const T inv = T{1} / det;
     for (size_t i = 0; i < R; ++i)
     {
-        os << "[";
         for (size_t j = 0; j < C; ++j)
         {
-            os << m.data[i][j];
-            if (j != C - 1)
+            res.data[i][j] *= inv;
+        }
+    }
+
+    return res;
+}
+
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> gaussianSolve(const Matrix<R, R, T> &A, const Matrix<R, C, T> &B)
+{
+    // Left side is the coefficient matrix, right side the right-hand sides
+    Matrix<R, R + C, T> aug{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < R; ++j)
+        {
+            aug.data[i][j] = A.data[i][j];
+        }
+        for (size_t j = 0; j < C; ++j)
+        {
+            aug.data[i][j + R] = B.data[i][j];
+        }
+    }
+
+    // Reduce the left side to upper triangle form
+    for (size_t c = 0; c < R; ++c)
+    {
+        size_t row = -1;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // Largest magnitude, for stability
+            T best = T{0};
+            for (size_t i = c; i < R; ++i)
             {
-                os << " ";
+                const T mag = aug.data[i][c] < T{0} ? -aug.data[i][c] : aug.data[i][c];
+                if (mag > best)
+                {
+                    best = mag;
+                    row = i;
+                }
             }
         }
-        os << "]";
-        if (i != R - 1)
+        else
         {
-            os << "\n";
+            // First nonzero
+            for (size_t i = c; i < R; ++i)
+            {
+                if (aug.data[i][c] != T{0})
+                {
+                    row = i;
+                    break;
+                }
+            }
+        }
+        if (row == -1UL)
+        {
+            printf("No solution: reached a state where column %ld is null\n\n", c);
+            return Matrix<R, C, T>();
+        }
+
+        if (row != c)
+        {
+            aug.swapRows(row, c);
+        }
+
+        // Eliminate below the pivot; cells left of c are already zero in the pivot row
+        const T inv = T{1} / aug.data[c][c];
+        for (size_t i = c + 1; i < R; ++i)
+        {
+            if (aug.data[i][c] == T{0})
+                continue;
+
+            const T factor = -(aug.data[i][c] * inv);
+            aug.data[i][c] = T{0};
+
+            const size_t n = R + C - c - 1;
+            if constexpr (hasSimd<T>)
+            {
+                if (n >= simdMinimumCells)
+                {
+                    simdAddScaled(&aug.data[i][c + 1], &aug.data[c][c + 1], factor, n);
+                    continue;
+                }
+            }
+
+            for (size_t j = c + 1; j < R + C; ++j)
+            {
+                multiplyAdd(aug.data[i][j], factor, aug.data[c][j]);
+            }
         }
     }
 
-    return os;
+    // Back substitution, one row of X at a time from the bottom
+    Matrix<R, C, T> X{};
+    for (size_t i = R; i-- > 0;)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            X.data[i][j] = aug.data[i][j + R];
+        }
+        for (size_t k = i + 1; k < R; ++k)
+        {
+            const T u = -aug.data[i][k];
+            if (u == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+            {
+                multiplyAdd(X.data[i][j], u, X.data[k][j]);
+            }
+        }
+        X.multiplyRow(i, T{1} / aug.data[i][i]);
+    }
+
+    return X;
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> &Matrix<R, C, T>::operator=(const Matrix<R, C, T> &m)
+Matrix<R, C, T> solve(const Matrix<R, R, T> &A, const Matrix<R, C, T> &B)
+{
+    // Integer fraction systems can skip every intermediate reduction. Minors may outgrow
+    // 64 bits where reduced fractions don't, so those fall back on checked elimination
+    if constexpr (std::is_same_v<T, Fraction>)
+    {
+        if (hasIntegerEntries(A) && hasIntegerEntries(B))
+        {
+            try
+            {
+                return bareissSolve(A, B);
+            }
+            catch (const std::overflow_error &)
+            {
+            }
+        }
+    }
+
+    return gaussianSolve(A, B);
+}
+
+template <size_t R, typename T>
+std::array<T, R> solve(const Matrix<R, R, T> &A, const std::array<T, R> &b)
+{
+    Matrix<R, 1, T> B{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        B.data[i][0] = b[i];
+    }
+
+    const Matrix<R, 1, T> X = solve(A, B);
+
+    std::array<T, R> x{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        x[i] = X.data[i][0];
+    }
+
+    return x;
+}
+
+template <size_t R, size_t C, typename T>
+std::ostream &operator<<(std::ostream &os, const Matrix<R, C, T> &m)
 {
     for (size_t i = 0; i < R; ++i)
     {
+        os << "[";
         for (size_t j = 0; j < C; ++j)
         {
-            data[i][j] = m.data[i][j];
+            os << m.data[i][j];
+            if (j != C - 1)
+            {
+                os << " ";
+            }
+        }
+        os << "]";
+        if (i != R - 1)
+        {
+            os << "\n";
         }
     }
+
+    return os;
 }
 
 template <size_t R, size_t C, typename T>
-bool Matrix<R, C, T>::operator==(const Matrix<R, C, T> &m) const
+constexpr bool Matrix<R, C, T>::operator==(const Matrix<R, C, T> &m) const
 {
     for (size_t i = 0; i < R; ++i)
     {
@@ -500,13 +1166,13 @@ bool Matrix<R, C, T>::operator==(const Matrix<R, C, T> &m) const
 }
 
 template <size_t R, size_t C, typename T>
-bool Matrix<R, C, T>::operator!=(const Matrix<R, C, T> &m) const
+constexpr bool Matrix<R, C, T>::operator!=(const Matrix<R, C, T> &m) const
 {
     return !(*this == m);
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> Matrix<R, C, T>::operator+(const Matrix<R, C, T> &m) const
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator+(const Matrix<R, C, T> &m) const &
 {
     Matrix<R, C, T> tmp{*this};
     tmp += m;
@@ -514,8 +1180,43 @@ Matrix<R, C, T> Matrix<R, C, T>::operator+(const Matrix<R, C, T> &m) const
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> &Matrix<R, C, T>::operator+=(const Matrix<R, C, T> &m)
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator+(const Matrix<R, C, T> &m) &&
+{
+    *this += m;
+    return std::move(*this);
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator+(const Matrix<R, C, T> &m0, Matrix<R, C, T> &&m1)
+{
+    // Addition commutes, so the result can be accumulated on the right side
+    m1 += m0;
+    return std::move(m1);
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator+(Matrix<R, C, T> &&m0, Matrix<R, C, T> &&m1)
 {
+    m0 += m1;
+    return std::move(m0);
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> &Matrix<R, C, T>::operator+=(const Matrix<R, C, T> &m)
+{
+    if constexpr (R * C <= unrollMaximumCells)
+    {
+        unroll<R * C>([&](auto k)
+                      { data[k / C][k % C] += m.data[k / C][k % C]; });
+        return *this;
+    }
+
+    if constexpr (hasSimd<T> && R * C >= simdMinimumCells)
+    {
+        simdAdd(&data[0][0], &m.data[0][0], R * C);
+        return *this;
+    }
+
     for (size_t i = 0; i < R; ++i)
     {
         for (size_t j = 0; j < C; ++j)
@@ -528,7 +1229,7 @@ Matrix<R, C, T> &Matrix<R, C, T>::operator+=(const Matrix<R, C, T> &m)
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> Matrix<R, C, T>::operator-(const Matrix<R, C, T> &m) const
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator-(const Matrix<R, C, T> &m) const &
 {
     Matrix<R, C, T> tmp{*this};
     tmp -= m;
@@ -536,60 +1237,176 @@ Matrix<R, C, T> Matrix<R, C, T>::operator-(const Matrix<R, C, T> &m) const
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> &Matrix<R, C, T>::operator-=(const Matrix<R, C, T> &m)
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator-(const Matrix<R, C, T> &m) &&
 {
-    return *this += -m;
+    *this -= m;
+    return std::move(*this);
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> Matrix<R, C, T>::operator-() const
+constexpr Matrix<R, C, T> operator-(const Matrix<R, C, T> &m0, Matrix<R, C, T> &&m1)
 {
-    Matrix<R, C, T> m{*this};
+    if constexpr (R * C <= unrollMaximumCells)
+    {
+        unroll<R * C>([&](auto k)
+                      { m1.data[k / C][k % C] = m0.data[k / C][k % C] - m1.data[k / C][k % C]; });
+        return std::move(m1);
+    }
+
+    if constexpr (hasSimd<T> && R * C >= simdMinimumCells)
+    {
+        simdReverseSubtract(&m1.data[0][0], &m0.data[0][0], R * C);
+        return std::move(m1);
+    }
 
     for (size_t i = 0; i < R; ++i)
     {
         for (size_t j = 0; j < C; ++j)
         {
-            m.data[i][j] = -data[i][j];
+            m1.data[i][j] = m0.data[i][j] - m1.data[i][j];
         }
     }
 
-    return m;
+    return std::move(m1);
 }
 
-template <size_t R, size_t M, size_t C, typename T>
-Matrix<R, C, T> operator*(const Matrix<R, M, T> &m0, const Matrix<M, C, T> &m1)
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> operator-(Matrix<R, C, T> &&m0, Matrix<R, C, T> &&m1)
 {
-    Matrix<R, C, T> res{};
+    m0 -= m1;
+    return std::move(m0);
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> &Matrix<R, C, T>::operator-=(const Matrix<R, C, T> &m)
+{
+    if constexpr (R * C <= unrollMaximumCells)
+    {
+        unroll<R * C>([&](auto k)
+                      { data[k / C][k % C] -= m.data[k / C][k % C]; });
+        return *this;
+    }
+
+    if constexpr (hasSimd<T> && R * C >= simdMinimumCells)
+    {
+        simdSubtract(&data[0][0], &m.data[0][0], R * C);
+        return *this;
+    }
+
     for (size_t i = 0; i < R; ++i)
     {
         for (size_t j = 0; j < C; ++j)
         {
-            for (size_t k = 0; k < M; ++k)
-                res.data[i][j] += m0.data[i][k] * m1.data[k][j];
+            data[i][j] -= m.data[i][j];
         }
     }
 
-    return res;
+    return *this;
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator-() const &
+{
+    Matrix<R, C, T> m{*this};
+    return -std::move(m);
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> &Matrix<R, C, T>::operator*=(const Matrix<R, C, T> &m)
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator-() &&
 {
+    if constexpr (R * C <= unrollMaximumCells)
+    {
+        unroll<R * C>([&](auto k)
+                      { data[k / C][k % C] = -data[k / C][k % C]; });
+        return std::move(*this);
+    }
+
+    if constexpr (hasSimd<T> && R * C >= simdMinimumCells)
+    {
+        simdNegate(&data[0][0], R * C);
+        return std::move(*this);
+    }
+
     for (size_t i = 0; i < R; ++i)
     {
         for (size_t j = 0; j < C; ++j)
         {
-            for (size_t k = 0; k < C; ++k)
-                data[i][j] += data[i][k] * m.data[k][j];
+            data[i][j] = -data[i][j];
         }
     }
 
-    return *this;
+    return std::move(*this);
+}
+
+template <size_t R, size_t M, size_t C, typename T>
+constexpr Matrix<R, C, T> operator*(const Matrix<R, M, T> &m0, const Matrix<M, C, T> &m1)
+{
+    Matrix<R, C, T> res{};
+
+    // Small products become one straight-line sum per cell
+    if constexpr (R * M * C <= unrollMaximumProduct)
+    {
+        unroll<R * C>([&](auto ij)
+                      {
+            constexpr size_t i = decltype(ij)::value / C;
+            constexpr size_t j = decltype(ij)::value % C;
+            if constexpr (std::is_same_v<T, Fraction>)
+            {
+                if (!__builtin_is_constant_evaluated())
+                {
+                    res.data[i][j] = dotProduct(&m0.data[i][0], 1, &m1.data[0][j], C, M);
+                    return;
+                }
+
+                // Constant evaluation rejects striding across rows, so the column is copied out
+                Fraction column[M];
+                unroll<M>([&](auto k)
+                          { column[k] = m1.data[k][j]; });
+                res.data[i][j] = dotProduct(&m0.data[i][0], 1, column, 1, M);
+            }
+            else
+                unroll<M>([&](auto k)
+                          { multiplyAdd(res.data[i][j], m0.data[i][k], m1.data[k][j]); }); });
+        return res;
+    }
+
+    // Large float and double products go through the packed, cache-blocked kernel
+    if constexpr (hasGemm<T> && R * M * C >= gemmThreshold)
+    {
+        gemm(R, C, M, &m0.data[0][0], M, &m1.data[0][0], C, &res.data[0][0], C);
+        return res;
+    }
+
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            // Fractions accumulate over a common denominator and reduce once per cell
+            if constexpr (std::is_same_v<T, Fraction>)
+            {
+                res.data[i][j] = dotProduct(&m0.data[i][0], 1, &m1.data[0][j], C, M);
+                continue;
+            }
+
+            for (size_t k = 0; k < M; ++k)
+                multiplyAdd(res.data[i][j], m0.data[i][k], m1.data[k][j]);
+        }
+    }
+
+    return res;
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> &Matrix<R, C, T>::operator*=(const Matrix<R, C, T> &m)
+{
+    static_assert((R == C) && "In-place product is defined only for square matrices");
+
+    // Every cell of the product reads a whole row of this matrix, so it can't be done in place
+    return *this = *this * m;
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> Matrix<R, C, T>::operator*(const T &s) const
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator*(const T &s) const &
 {
     Matrix<R, C, T> tmp{*this};
     tmp *= s;
@@ -597,8 +1414,28 @@ Matrix<R, C, T> Matrix<R, C, T>::operator*(const T &s) const
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> &Matrix<R, C, T>::operator*=(const T &s)
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator*(const T &s) &&
+{
+    *this *= s;
+    return std::move(*this);
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> &Matrix<R, C, T>::operator*=(const T &s)
 {
+    if constexpr (R * C <= unrollMaximumCells)
+    {
+        unroll<R * C>([&](auto k)
+                      { data[k / C][k % C] *= s; });
+        return *this;
+    }
+
+    if constexpr (hasSimd<T> && R * C >= simdMinimumCells)
+    {
+        simdScale(&data[0][0], s, R * C);
+        return *this;
+    }
+
     for (size_t i = 0; i < R; ++i)
     {
         for (size_t j = 0; j < C; ++j)
@@ -611,13 +1448,19 @@ Matrix<R, C, T> &Matrix<R, C, T>::operator*=(const T &s)
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> operator*(const T &s, const Matrix<R, C, T> &m)
+constexpr Matrix<R, C, T> operator*(const T &s, const Matrix<R, C, T> &m)
 {
     return m * s;
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> Matrix<R, C, T>::operator/(const T &s) const
+constexpr Matrix<R, C, T> operator*(const T &s, Matrix<R, C, T> &&m)
+{
+    return std::move(m) * s;
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator/(const T &s) const &
 {
     Matrix tmp{*this};
     tmp /= s;
@@ -625,7 +1468,14 @@ Matrix<R, C, T> Matrix<R, C, T>::operator/(const T &s) const
 }
 
 template <size_t R, size_t C, typename T>
-Matrix<R, C, T> &Matrix<R, C, T>::operator/=(const T &s)
+constexpr Matrix<R, C, T> Matrix<R, C, T>::operator/(const T &s) &&
+{
+    *this /= s;
+    return std::move(*this);
+}
+
+template <size_t R, size_t C, typename T>
+constexpr Matrix<R, C, T> &Matrix<R, C, T>::operator/=(const T &s)
 {
     return *this *= T{1} / s;
 }
@@ -633,6 +1483,12 @@ Matrix<R, C, T> &Matrix<R, C, T>::operator/=(const T &s)
 template <size_t R, size_t C, typename T>
 void Matrix<R, C, T>::swapRows(const size_t &r0, const size_t &r1)
 {
+    if constexpr (hasSimd<T> && C >= simdMinimumCells)
+    {
+        simdSwap(data[r0], data[r1], C);
+        return;
+    }
+
     for (size_t i = 0; i < C; ++i)
     {
         T tmp{data[r0][i]};
@@ -644,6 +1500,12 @@ void Matrix<R, C, T>::swapRows(const size_t &r0, const size_t &r1)
 template <size_t R, size_t C, typename T>
 void Matrix<R, C, T>::multiplyRow(const size_t &r, const T &s)
 {
+    if constexpr (hasSimd<T> && C >= simdMinimumCells)
+    {
+        simdScale(data[r], s, C);
+        return;
+    }
+
     for (size_t i = 0; i < C; ++i)
     {
         data[r][i] *= s;
@@ -653,8 +1515,17 @@ void Matrix<R, C, T>::multiplyRow(const size_t &r, const T &s)
 template <size_t R, size_t C, typename T>
 void Matrix<R, C, T>::addScaledRow(const size_t &r0, const size_t &r1, const T &s)
 {
+    if constexpr (hasSimd<T> && C >= simdMinimumCells)
+    {
+        simdAddScaled(data[r0], data[r1], s, C);
+        return;
+    }
+
     for (size_t i = 0; i < C; ++i)
     {
-        data[r0][i] += s * data[r1][i];
+        multiplyAdd(data[r0][i], s, data[r1][i]);
     }
-}
\ No newline at end of file
+}
+
+// Views use multiplyAdd and the forward declarations above
+#include <include/matrix_view.hpp>
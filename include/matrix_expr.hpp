@@ -0,0 +1,504 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+
+// Lazy matrix expressions. Wrapping a matrix with lazy() makes the arithmetic
+// operators build an expression tree instead of a Matrix at every step; the
+// tree is evaluated row by row, in a single pass, when assigned to a Matrix:
+//
+//     D = lazy(A) * B + C - A * s;
+//
+// Expressions hold references to their operands, so they must be assigned in
+// the same statement they are built in, never kept in an auto variable
+
+/// @brief Base of every lazy matrix expression
+/// @tparam E Concrete expression type
+template <typename E>
+struct MatrixExpr
+{
+    /// @brief Marks a type as an expression for Matrix's constructor and assignment
+    using isMatrixExpr = void;
+
+    /// @brief Concrete expression
+    /// @return This expression, downcast
+    const E &self() const { return static_cast<const E &>(*this); }
+};
+
+/// @brief Whether a type is a lazy matrix expression
+template <typename X>
+constexpr bool isMatrixExpr = std::is_base_of_v<MatrixExpr<std::decay_t<X>>, std::decay_t<X>>;
+
+/// @brief Whether a type is a fixed-size matrix
+template <typename X>
+struct IsMatrix : std::false_type
+{
+};
+
+template <size_t R, size_t C, typename T>
+struct IsMatrix<Matrix<R, C, T>> : std::true_type
+{
+};
+
+/// @brief Whether two operands can be combined into an expression: both must be expressions or
+/// matrices, and at least one must be an expression, so plain Matrix operators stay eager
+template <typename L, typename Rr>
+constexpr bool isExprOperands = (isMatrixExpr<L> || IsMatrix<std::decay_t<L>>::value) &&
+                                (isMatrixExpr<Rr> || IsMatrix<std::decay_t<Rr>>::value) &&
+                                (isMatrixExpr<L> || isMatrixExpr<Rr>);
+
+/// @brief Leaf expression, reads the cells of an existing matrix
+template <size_t R, size_t C, typename T>
+struct MatrixRef : MatrixExpr<MatrixRef<R, C, T>>
+{
+    static constexpr size_t rows = R;
+    static constexpr size_t cols = C;
+    using value_type = T;
+
+    /// @brief Referenced matrix
+    const Matrix<R, C, T> &m;
+
+    /// @brief Whether a product appears anywhere in this expression
+    static constexpr bool hasProduct = false;
+
+    /// @brief Constructor with referenced matrix
+    /// @param m Matrix
+    MatrixRef(const Matrix<R, C, T> &m) : m{m} {}
+
+    /// @brief Evaluates a cell
+    /// @param i Row
+    /// @param j Column
+    /// @return Cell value
+    const T &operator()(const size_t &i, const size_t &j) const { return m.data[i][j]; }
+
+    /// @brief Evaluates a row
+    /// @param i Row
+    /// @param out Receives the row's cells
+    void row(const size_t &i, T *out) const
+    {
+        for (size_t j = 0; j < C; ++j)
+            out[j] = m.data[i][j];
+    }
+
+    /// @brief Whether evaluating a row reads cells of dst outside that row, so dst can't be written in place
+    /// @return False, a leaf only reads the row being written
+    bool readsAround(const void *) const { return false; }
+
+    /// @brief Whether this leaf is the given matrix
+    /// @param dst Matrix address
+    /// @return Whether both are the same matrix
+    bool refersTo(const void *dst) const { return &m == dst; }
+};
+
+/// @brief Whether an expression is a leaf
+template <typename E>
+struct IsMatrixRef : std::false_type
+{
+};
+
+template <size_t R, size_t C, typename T>
+struct IsMatrixRef<MatrixRef<R, C, T>> : std::true_type
+{
+};
+
+/// @brief Whether an expression is evaluated one cell at a time. Fusing every operation into a
+/// single cell loop pays off for arithmetic types, which vectorize; types with branchy operations,
+/// like Fraction, run faster applying one operation at a time over a row. Products always work by rows
+template <typename E>
+constexpr bool isCellwise = std::is_arithmetic_v<typename E::value_type> && !E::hasProduct;
+
+/// @brief Combines row i of an expression into out, cell by cell. Leaves and cell-wise expressions
+/// are read in place, any other expression is evaluated into a row buffer first
+/// @param e Expression
+/// @param i Row
+/// @param out Row being built
+/// @param f Combines a cell of out with the matching cell of e
+template <typename E, typename F>
+void combineRow(const E &e, const size_t &i, typename E::value_type *out, F &&f)
+{
+    if constexpr (IsMatrixRef<E>::value)
+    {
+        const auto *src = e.m.data[i];
+        for (size_t j = 0; j < E::cols; ++j)
+            f(out[j], src[j]);
+    }
+    else if constexpr (isCellwise<E>)
+    {
+        for (size_t j = 0; j < E::cols; ++j)
+            f(out[j], e(i, j));
+    }
+    else
+    {
+        typename E::value_type tmp[E::cols];
+        e.row(i, tmp);
+        for (size_t j = 0; j < E::cols; ++j)
+            f(out[j], tmp[j]);
+    }
+}
+
+/// @brief Cell-wise sum of two expressions
+template <typename L, typename Rr>
+struct MatrixSum : MatrixExpr<MatrixSum<L, Rr>>
+{
+    static_assert(L::rows == Rr::rows && L::cols == Rr::cols, "Matrix orders don't match");
+    static_assert(std::is_same_v<typename L::value_type, typename Rr::value_type>, "Matrix types don't match");
+
+    static constexpr size_t rows = L::rows;
+    static constexpr size_t cols = L::cols;
+    using value_type = typename L::value_type;
+
+    L l;
+    Rr r;
+
+    static constexpr bool hasProduct = L::hasProduct || Rr::hasProduct;
+
+    MatrixSum(L l, Rr r) : l{std::move(l)}, r{std::move(r)} {}
+
+    value_type operator()(const size_t &i, const size_t &j) const { return l(i, j) + r(i, j); }
+
+    void row(const size_t &i, value_type *out) const
+    {
+        if constexpr (isCellwise<MatrixSum>)
+        {
+            for (size_t j = 0; j < cols; ++j)
+                out[j] = (*this)(i, j);
+            return;
+        }
+
+        l.row(i, out);
+        combineRow(r, i, out, [](value_type &a, const value_type &b)
+                   { a += b; });
+    }
+
+    bool readsAround(const void *dst) const { return l.readsAround(dst) || r.readsAround(dst); }
+
+    bool refersTo(const void *dst) const { return l.refersTo(dst) || r.refersTo(dst); }
+};
+
+/// @brief Cell-wise difference of two expressions
+template <typename L, typename Rr>
+struct MatrixDifference : MatrixExpr<MatrixDifference<L, Rr>>
+{
+    static_assert(L::rows == Rr::rows && L::cols == Rr::cols, "Matrix orders don't match");
+    static_assert(std::is_same_v<typename L::value_type, typename Rr::value_type>, "Matrix types don't match");
+
+    static constexpr size_t rows = L::rows;
+    static constexpr size_t cols = L::cols;
+    using value_type = typename L::value_type;
+
+    L l;
+    Rr r;
+
+    static constexpr bool hasProduct = L::hasProduct || Rr::hasProduct;
+
+    MatrixDifference(L l, Rr r) : l{std::move(l)}, r{std::move(r)} {}
+
+    value_type operator()(const size_t &i, const size_t &j) const { return l(i, j) - r(i, j); }
+
+    void row(const size_t &i, value_type *out) const
+    {
+        if constexpr (isCellwise<MatrixDifference>)
+        {
+            for (size_t j = 0; j < cols; ++j)
+                out[j] = (*this)(i, j);
+            return;
+        }
+
+        l.row(i, out);
+        combineRow(r, i, out, [](value_type &a, const value_type &b)
+                   { a -= b; });
+    }
+
+    bool readsAround(const void *dst) const { return l.readsAround(dst) || r.readsAround(dst); }
+
+    bool refersTo(const void *dst) const { return l.refersTo(dst) || r.refersTo(dst); }
+};
+
+/// @brief Expression with every cell's sign flipped
+template <typename E>
+struct MatrixNegate : MatrixExpr<MatrixNegate<E>>
+{
+    static constexpr size_t rows = E::rows;
+    static constexpr size_t cols = E::cols;
+    using value_type = typename E::value_type;
+
+    E e;
+
+    static constexpr bool hasProduct = E::hasProduct;
+
+    MatrixNegate(E e) : e{std::move(e)} {}
+
+    value_type operator()(const size_t &i, const size_t &j) const { return -e(i, j); }
+
+    void row(const size_t &i, value_type *out) const
+    {
+        if constexpr (isCellwise<MatrixNegate>)
+        {
+            for (size_t j = 0; j < cols; ++j)
+                out[j] = (*this)(i, j);
+            return;
+        }
+
+        e.row(i, out);
+        for (size_t j = 0; j < cols; ++j)
+            out[j] = -out[j];
+    }
+
+    bool readsAround(const void *dst) const { return e.readsAround(dst); }
+
+    bool refersTo(const void *dst) const { return e.refersTo(dst); }
+};
+
+/// @brief Expression with every cell multiplied by a scalar
+template <typename E>
+struct MatrixScale : MatrixExpr<MatrixScale<E>>
+{
+    static constexpr size_t rows = E::rows;
+    static constexpr size_t cols = E::cols;
+    using value_type = typename E::value_type;
+
+    E e;
+    value_type s;
+
+    static constexpr bool hasProduct = E::hasProduct;
+
+    MatrixScale(E e, const value_type &s) : e{std::move(e)}, s{s} {}
+
+    value_type operator()(const size_t &i, const size_t &j) const { return e(i, j) * s; }
+
+    void row(const size_t &i, value_type *out) const
+    {
+        if constexpr (isCellwise<MatrixScale>)
+        {
+            for (size_t j = 0; j < cols; ++j)
+                out[j] = (*this)(i, j);
+            return;
+        }
+
+        e.row(i, out);
+        for (size_t j = 0; j < cols; ++j)
+            out[j] *= s;
+    }
+
+    bool readsAround(const void *dst) const { return e.readsAround(dst); }
+
+    bool refersTo(const void *dst) const { return e.refersTo(dst); }
+};
+
+/// @brief Operand of a product. Every cell is read once per row or column of the result, so
+/// matrices are read in place and any other expression is evaluated once up front
+template <typename E>
+struct ProductOperand
+{
+    using Result = Matrix<E::rows, E::cols, typename E::value_type>;
+
+    Result m;
+
+    ProductOperand(const E &e) : m{e} {}
+
+    const Result &matrix() const { return m; }
+
+    bool refersTo(const void *) const { return false; }
+};
+
+template <size_t R, size_t C, typename T>
+struct ProductOperand<MatrixRef<R, C, T>>
+{
+    MatrixRef<R, C, T> ref;
+
+    ProductOperand(const MatrixRef<R, C, T> &ref) : ref{ref} {}
+
+    const Matrix<R, C, T> &matrix() const { return ref.m; }
+
+    bool refersTo(const void *dst) const { return ref.refersTo(dst); }
+};
+
+/// @brief Matrix product of two expressions
+template <typename L, typename Rr>
+struct MatrixProduct : MatrixExpr<MatrixProduct<L, Rr>>
+{
+    static_assert(L::cols == Rr::rows, "Left matrix's columns must match right matrix's rows");
+    static_assert(std::is_same_v<typename L::value_type, typename Rr::value_type>, "Matrix types don't match");
+
+    static constexpr size_t rows = L::rows;
+    static constexpr size_t cols = Rr::cols;
+    using value_type = typename L::value_type;
+
+    static constexpr bool hasProduct = true;
+
+    /// @brief Whether the product goes through the blocked kernel, which needs the whole operands
+    /// at once, so it is computed up front instead of row by row. Fusing rows is faster as long
+    /// as the right operand fits in L1
+    static constexpr bool useGemm = hasGemm<value_type> && L::cols * cols * sizeof(value_type) > 32 * 1024;
+
+    ProductOperand<L> l;
+    ProductOperand<Rr> r;
+
+    /// @brief Whole product, only when computed up front
+    std::conditional_t<useGemm, Matrix<rows, cols, value_type>, std::tuple<>> product;
+
+    MatrixProduct(const L &l, const Rr &r) : l{l}, r{r}
+    {
+        if constexpr (useGemm)
+            product = this->l.matrix() * this->r.matrix();
+    }
+
+    void row(const size_t &i, value_type *out) const
+    {
+        const auto &a = l.matrix();
+        const auto &b = r.matrix();
+
+        if constexpr (useGemm)
+        {
+            for (size_t j = 0; j < cols; ++j)
+                out[j] = product.data[i][j];
+        }
+        // Fractions accumulate over a common denominator and reduce once per cell
+        else if constexpr (std::is_same_v<value_type, Fraction>)
+        {
+            for (size_t j = 0; j < cols; ++j)
+                out[j] = dotProduct(&a.data[i][0], 1, &b.data[0][j], cols, L::cols);
+        }
+        else
+        {
+            // Broadcast each cell of the left row over a right row, so the inner loop is contiguous.
+            // Every cell still sums its products in k order, same as the eager product.
+            // A local accumulator can't alias the operands, so it stays vectorized
+            value_type acc[cols];
+            for (size_t j = 0; j < cols; ++j)
+                acc[j] = value_type{0};
+            for (size_t k = 0; k < L::cols; ++k)
+            {
+                for (size_t j = 0; j < cols; ++j)
+                    multiplyAdd(acc[j], a.data[i][k], b.data[k][j]);
+            }
+            for (size_t j = 0; j < cols; ++j)
+                out[j] = acc[j];
+        }
+    }
+
+    bool readsAround(const void *dst) const
+    {
+        // A product computed up front no longer reads its operands
+        return !useGemm && (l.refersTo(dst) || r.refersTo(dst));
+    }
+
+    bool refersTo(const void *dst) const { return readsAround(dst); }
+};
+
+/// @brief Starts a lazy expression from a matrix
+/// @param m Matrix, must outlive the expression
+/// @return Expression reading the matrix
+template <size_t R, size_t C, typename T>
+MatrixRef<R, C, T> lazy(const Matrix<R, C, T> &m)
+{
+    return MatrixRef<R, C, T>{m};
+}
+
+/// @brief Temporaries would be destroyed before the expression is evaluated
+template <size_t R, size_t C, typename T>
+MatrixRef<R, C, T> lazy(const Matrix<R, C, T> &&m) = delete;
+
+/// @brief Expression operand from an expression
+template <typename E>
+E asExpr(const MatrixExpr<E> &e)
+{
+    return e.self();
+}
+
+/// @brief Expression operand from a matrix
+template <size_t R, size_t C, typename T>
+MatrixRef<R, C, T> asExpr(const Matrix<R, C, T> &m)
+{
+    return MatrixRef<R, C, T>{m};
+}
+
+/// @brief Expression type of an operand
+template <typename X>
+using ExprOf = decltype(asExpr(std::declval<const X &>()));
+
+template <typename L, typename Rr, typename = std::enable_if_t<isExprOperands<L, Rr>>>
+MatrixSum<ExprOf<L>, ExprOf<Rr>> operator+(const L &l, const Rr &r)
+{
+    return {asExpr(l), asExpr(r)};
+}
+
+template <typename L, typename Rr, typename = std::enable_if_t<isExprOperands<L, Rr>>>
+MatrixDifference<ExprOf<L>, ExprOf<Rr>> operator-(const L &l, const Rr &r)
+{
+    return {asExpr(l), asExpr(r)};
+}
+
+template <typename L, typename Rr, typename = std::enable_if_t<isExprOperands<L, Rr>>>
+MatrixProduct<ExprOf<L>, ExprOf<Rr>> operator*(const L &l, const Rr &r)
+{
+    return {asExpr(l), asExpr(r)};
+}
+
+template <typename E>
+MatrixNegate<E> operator-(const MatrixExpr<E> &e)
+{
+    return {e.self()};
+}
+
+template <typename E>
+MatrixScale<E> operator*(const MatrixExpr<E> &e, const typename E::value_type &s)
+{
+    return {e.self(), s};
+}
+
+template <typename E>
+MatrixScale<E> operator*(const typename E::value_type &s, const MatrixExpr<E> &e)
+{
+    return {e.self(), s};
+}
+
+template <typename E>
+MatrixScale<E> operator/(const MatrixExpr<E> &e, const typename E::value_type &s)
+{
+    // Same as Matrix::operator/=, which multiplies by the inverse
+    return {e.self(), typename E::value_type{1} / s};
+}
+
+/// @brief Evaluates an expression into a matrix in a single pass. When the expression reads
+/// rows of the destination other than the one being written (e.g. A = A * B), it is
+/// evaluated into a temporary first. When it only reads the row being written (e.g.
+/// A = B + A), each row is built in a buffer, since operations applied a row at a time
+/// overwrite cells of dst before their last read
+/// @param dst Destination matrix
+/// @param e Expression
+template <size_t R, size_t C, typename T, typename E>
+void evaluateInto(Matrix<R, C, T> &dst, const MatrixExpr<E> &e)
+{
+    static_assert(E::rows == R && E::cols == C, "Matrix orders don't match");
+    static_assert(std::is_same_v<typename E::value_type, T>, "Matrix types don't match");
+
+    const E &x = e.self();
+    if (x.readsAround(&dst))
+    {
+        Matrix<R, C, T> tmp{x};
+        dst = std::move(tmp);
+        return;
+    }
+
+    if (x.refersTo(&dst))
+    {
+        T tmp[C];
+        for (size_t i = 0; i < R; ++i)
+        {
+            x.row(i, tmp);
+            for (size_t j = 0; j < C; ++j)
+                dst.data[i][j] = std::move(tmp[j]);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < R; ++i)
+    {
+        x.row(i, dst.data[i]);
+    }
+}
@@ -0,0 +1,423 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include <include/matrix.hpp>
+
+// Non-owning views of matrix cells. A view is a pointer to its first cell plus
+// a row stride and a column stride, in cells, so it can address any block of a
+// Matrix or DynMatrix, every other row or column, or the transpose (strides
+// swapped) without moving data. MatrixView<T> reads cells, MatrixSpan<T> may
+// also write them, and a span converts to a view.
+//
+// Views don't own their cells: they must not outlive the matrix they look into.
+// The view* kernels below take any mix of views and spans and write their result
+// into a span, which may not overlap their inputs (viewAdd, viewSubtract and
+// viewScale excepted, which may write into one of their inputs)
+
+/// @brief Non-owning, strided view of matrix cells
+/// @tparam E Cell type, const-qualified for read-only views
+template <typename E>
+class BasicMatrixView
+{
+public:
+    /// @brief Cell type without qualifiers
+    using value_type = std::remove_const_t<E>;
+
+    /// @brief Empty view, of order 0x0
+    BasicMatrixView() = default;
+
+    /// @brief View of cells laid out with the given strides
+    /// @param data First cell
+    /// @param rows Number of rows
+    /// @param cols Number of columns
+    /// @param rowStride Distance in cells between two consecutive rows
+    /// @param colStride Distance in cells between two consecutive columns
+    BasicMatrixView(E *data, const size_t &rows, const size_t &cols, const size_t &rowStride, const size_t &colStride = 1);
+
+    /// @brief Read-only view of a writable one
+    template <typename F, typename = std::enable_if_t<std::is_same_v<const F, E> && !std::is_same_v<F, E>>>
+    BasicMatrixView(const BasicMatrixView<F> &v);
+
+    /// @brief Number of rows
+    size_t rows() const;
+
+    /// @brief Number of columns
+    size_t cols() const;
+
+    /// @brief Distance in cells between two consecutive rows
+    size_t rowStride() const;
+
+    /// @brief Distance in cells between two consecutive columns
+    size_t colStride() const;
+
+    /// @brief First cell
+    E *data() const;
+
+    /// @brief Cell access
+    /// @param i Row
+    /// @param j Column
+    /// @return Reference to the cell
+    E &operator()(const size_t &i, const size_t &j) const;
+
+    /// @brief Block of this view
+    /// @param r First row
+    /// @param c First column
+    /// @param rows Number of rows
+    /// @param cols Number of columns
+    /// @return View of the block
+    BasicMatrixView<E> block(const size_t &r, const size_t &c, const size_t &rows, const size_t &cols) const;
+
+    /// @brief One row, as a 1 x cols() view
+    BasicMatrixView<E> row(const size_t &i) const;
+
+    /// @brief One column, as a rows() x 1 view
+    BasicMatrixView<E> column(const size_t &j) const;
+
+    /// @brief Every rowStep-th row and colStep-th column, starting with the first
+    /// @param rowStep Row step, at least 1
+    /// @param colStep Column step, at least 1
+    /// @return Strided view
+    BasicMatrixView<E> strided(const size_t &rowStep, const size_t &colStep) const;
+
+    /// @brief Transposed view, swapping the strides
+    BasicMatrixView<E> transpose() const;
+
+private:
+    E *first = nullptr;
+    size_t nRows = 0;
+    size_t nCols = 0;
+    size_t rStride = 0;
+    size_t cStride = 1;
+};
+
+/// @brief Read-only view of matrix cells
+template <typename T>
+using MatrixView = BasicMatrixView<const T>;
+
+/// @brief Writable view of matrix cells
+template <typename T>
+using MatrixSpan = BasicMatrixView<T>;
+
+/// @brief Copies a view's cells into a span of the same order
+/// @param src Source
+/// @param dst Destination
+template <typename A, typename T>
+void viewCopy(const BasicMatrixView<A> &src, const MatrixSpan<T> &dst);
+
+/// @brief Cell-wise sum, dst = a + b
+template <typename A, typename B, typename T>
+void viewAdd(const BasicMatrixView<A> &a, const BasicMatrixView<B> &b, const MatrixSpan<T> &dst);
+
+/// @brief Cell-wise difference, dst = a - b
+template <typename A, typename B, typename T>
+void viewSubtract(const BasicMatrixView<A> &a, const BasicMatrixView<B> &b, const MatrixSpan<T> &dst);
+
+/// @brief Product with scalar, dst = s * a
+template <typename A, typename T>
+void viewScale(const BasicMatrixView<A> &a, const T &s, const MatrixSpan<T> &dst);
+
+/// @brief Matrix product, dst = a * b
+/// @param a Left operand
+/// @param b Right operand
+/// @param dst Result, of order a.rows() x b.cols()
+template <typename A, typename B, typename T>
+void viewMultiply(const BasicMatrixView<A> &a, const BasicMatrixView<B> &b, const MatrixSpan<T> &dst);
+
+/// @brief Determinant by Gaussian elimination in place: the span is left as U
+/// @param m Square span, overwritten
+/// @return Determinant
+template <typename T>
+T viewDeterminant(const MatrixSpan<T> &m);
+
+/// @brief Solves A * X = B by Gaussian elimination in place: A is left as U and B as X
+/// @param A Square coefficient span, overwritten
+/// @param B Right-hand sides, overwritten with the solution
+/// @return Whether A is nonsingular; if not, B is left partially eliminated
+template <typename T>
+bool viewSolve(const MatrixSpan<T> &A, const MatrixSpan<T> &B);
+
+template <typename E>
+BasicMatrixView<E>::BasicMatrixView(E *data, const size_t &rows, const size_t &cols, const size_t &rowStride, const size_t &colStride)
+    : first{data}, nRows{rows}, nCols{cols}, rStride{rowStride}, cStride{colStride}
+{
+}
+
+template <typename E>
+template <typename F, typename>
+BasicMatrixView<E>::BasicMatrixView(const BasicMatrixView<F> &v)
+    : first{v.data()}, nRows{v.rows()}, nCols{v.cols()}, rStride{v.rowStride()}, cStride{v.colStride()}
+{
+}
+
+template <typename E>
+size_t BasicMatrixView<E>::rows() const
+{
+    return nRows;
+}
+
+template <typename E>
+size_t BasicMatrixView<E>::cols() const
+{
+    return nCols;
+}
+
+template <typename E>
+size_t BasicMatrixView<E>::rowStride() const
+{
+    return rStride;
+}
+
+template <typename E>
+size_t BasicMatrixView<E>::colStride() const
+{
+    return cStride;
+}
+
+template <typename E>
+E *BasicMatrixView<E>::data() const
+{
+    return first;
+}
+
+template <typename E>
+E &BasicMatrixView<E>::operator()(const size_t &i, const size_t &j) const
+{
+    assert((i < nRows && j < nCols) && "Cell out of range");
+    return first[i * rStride + j * cStride];
+}
+
+template <typename E>
+BasicMatrixView<E> BasicMatrixView<E>::block(const size_t &r, const size_t &c, const size_t &rows, const size_t &cols) const
+{
+    assert((r + rows <= nRows && c + cols <= nCols) && "Block out of range");
+    return BasicMatrixView<E>{first + r * rStride + c * cStride, rows, cols, rStride, cStride};
+}
+
+template <typename E>
+BasicMatrixView<E> BasicMatrixView<E>::row(const size_t &i) const
+{
+    return block(i, 0, 1, nCols);
+}
+
+template <typename E>
+BasicMatrixView<E> BasicMatrixView<E>::column(const size_t &j) const
+{
+    return block(0, j, nRows, 1);
+}
+
+template <typename E>
+BasicMatrixView<E> BasicMatrixView<E>::strided(const size_t &rowStep, const size_t &colStep) const
+{
+    assert((rowStep > 0 && colStep > 0) && "Steps must be positive");
+    return BasicMatrixView<E>{first, (nRows + rowStep - 1) / rowStep, (nCols + colStep - 1) / colStep, rStride * rowStep, cStride * colStep};
+}
+
+template <typename E>
+BasicMatrixView<E> BasicMatrixView<E>::transpose() const
+{
+    return BasicMatrixView<E>{first, nCols, nRows, cStride, rStride};
+}
+
+template <typename A, typename T>
+void viewCopy(const BasicMatrixView<A> &src, const MatrixSpan<T> &dst)
+{
+    assert((src.rows() == dst.rows() && src.cols() == dst.cols()) && "Matrices' orders must match");
+
+    for (size_t i = 0; i < dst.rows(); ++i)
+    {
+        for (size_t j = 0; j < dst.cols(); ++j)
+            dst(i, j) = src(i, j);
+    }
+}
+
+template <typename A, typename B, typename T>
+void viewAdd(const BasicMatrixView<A> &a, const BasicMatrixView<B> &b, const MatrixSpan<T> &dst)
+{
+    assert((a.rows() == b.rows() && a.cols() == b.cols()) && "Matrices' orders must match");
+    assert((a.rows() == dst.rows() && a.cols() == dst.cols()) && "Matrices' orders must match");
+
+    for (size_t i = 0; i < dst.rows(); ++i)
+    {
+        for (size_t j = 0; j < dst.cols(); ++j)
+            dst(i, j) = a(i, j) + b(i, j);
+    }
+}
+
+template <typename A, typename B, typename T>
+void viewSubtract(const BasicMatrixView<A> &a, const BasicMatrixView<B> &b, const MatrixSpan<T> &dst)
+{
+    assert((a.rows() == b.rows() && a.cols() == b.cols()) && "Matrices' orders must match");
+    assert((a.rows() == dst.rows() && a.cols() == dst.cols()) && "Matrices' orders must match");
+
+    for (size_t i = 0; i < dst.rows(); ++i)
+    {
+        for (size_t j = 0; j < dst.cols(); ++j)
+            dst(i, j) = a(i, j) - b(i, j);
+    }
+}
+
+template <typename A, typename T>
+void viewScale(const BasicMatrixView<A> &a, const T &s, const MatrixSpan<T> &dst)
+{
+    assert((a.rows() == dst.rows() && a.cols() == dst.cols()) && "Matrices' orders must match");
+
+    for (size_t i = 0; i < dst.rows(); ++i)
+    {
+        for (size_t j = 0; j < dst.cols(); ++j)
+            dst(i, j) = s * a(i, j);
+    }
+}
+
+template <typename A, typename B, typename T>
+void viewMultiply(const BasicMatrixView<A> &a, const BasicMatrixView<B> &b, const MatrixSpan<T> &dst)
+{
+    assert((a.cols() == b.rows()) && "Left matrix's columns must match right matrix's rows");
+    assert((a.rows() == dst.rows() && b.cols() == dst.cols()) && "Result's order must match the product's");
+
+    for (size_t i = 0; i < dst.rows(); ++i)
+    {
+        for (size_t j = 0; j < dst.cols(); ++j)
+            dst(i, j) = T{0};
+
+        // i-k-j order walks rows of b and dst, whatever the strides of a
+        for (size_t k = 0; k < a.cols(); ++k)
+        {
+            const T s = a(i, k);
+            if (s == T{0})
+                continue;
+
+            for (size_t j = 0; j < dst.cols(); ++j)
+                multiplyAdd(dst(i, j), s, T(b(k, j)));
+        }
+    }
+}
+
+/// @brief Row of a span holding a pivot for column c at or below row c: the largest magnitude for
+/// floating types, the first nonzero cell for exact ones, like LU
+/// @return Pivot row, or -1 if the column is null from row c down
+template <typename T>
+size_t viewPivot(const MatrixSpan<T> &m, const size_t &c)
+{
+    size_t row = -1;
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        T best = T{0};
+        for (size_t i = c; i < m.rows(); ++i)
+        {
+            if (std::abs(m(i, c)) > best)
+            {
+                best = std::abs(m(i, c));
+                row = i;
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = c; i < m.rows() && row == -1UL; ++i)
+        {
+            if (m(i, c) != T{0})
+                row = i;
+        }
+    }
+
+    return row;
+}
+
+template <typename T>
+T viewDeterminant(const MatrixSpan<T> &m)
+{
+    assert((m.rows() == m.cols()) && "Determinant is defined only for square matrices");
+
+    T det{1};
+    for (size_t c = 0; c < m.rows(); ++c)
+    {
+        const size_t row = viewPivot(m, c);
+        if (row == -1UL)
+            return T{0};
+
+        if (row != c)
+        {
+            det = -det;
+            for (size_t j = c; j < m.cols(); ++j)
+                std::swap(m(row, j), m(c, j));
+        }
+
+        det *= m(c, c);
+        const T inv = T{1} / m(c, c);
+        for (size_t i = c + 1; i < m.rows(); ++i)
+        {
+            if (m(i, c) == T{0})
+                continue;
+
+            const T l = m(i, c) * inv;
+            m(i, c) = T{0};
+            for (size_t j = c + 1; j < m.cols(); ++j)
+                multiplyAdd(m(i, j), -l, m(c, j));
+        }
+    }
+
+    return det;
+}
+
+template <typename T>
+bool viewSolve(const MatrixSpan<T> &A, const MatrixSpan<T> &B)
+{
+    assert((A.rows() == A.cols()) && "Coefficient matrix must be square");
+    assert((A.rows() == B.rows()) && "Right-hand sides' rows must match matrix's order");
+
+    const size_t n = A.rows();
+    for (size_t c = 0; c < n; ++c)
+    {
+        const size_t row = viewPivot(A, c);
+        if (row == -1UL)
+            return false;
+
+        if (row != c)
+        {
+            for (size_t j = c; j < n; ++j)
+                std::swap(A(row, j), A(c, j));
+            for (size_t j = 0; j < B.cols(); ++j)
+                std::swap(B(row, j), B(c, j));
+        }
+
+        const T inv = T{1} / A(c, c);
+        for (size_t i = c + 1; i < n; ++i)
+        {
+            if (A(i, c) == T{0})
+                continue;
+
+            const T l = A(i, c) * inv;
+            A(i, c) = T{0};
+            for (size_t j = c + 1; j < n; ++j)
+                multiplyAdd(A(i, j), -l, A(c, j));
+            for (size_t j = 0; j < B.cols(); ++j)
+                multiplyAdd(B(i, j), -l, B(c, j));
+        }
+    }
+
+    // Backward substitution
+    for (size_t i = n; i-- > 0;)
+    {
+        for (size_t k = i + 1; k < n; ++k)
+        {
+            const T u = A(i, k);
+            if (u == T{0})
+                continue;
+
+            for (size_t j = 0; j < B.cols(); ++j)
+                multiplyAdd(B(i, j), -u, B(k, j));
+        }
+
+        const T inv = T{1} / A(i, i);
+        for (size_t j = 0; j < B.cols(); ++j)
+            B(i, j) *= inv;
+    }
+
+    return true;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <ostream>
+#include <cstdint>
+#include <cassert>
+
+/// @brief Integer modulo a word-size prime, usable as a Matrix data type.
+/// The modulus is shared by all values of the current thread, so each worker
+/// thread can run a whole elimination under its own prime
+class Modular
+{
+public:
+    /// @brief Current thread's prime modulus, must be below 2^32 so products fit in 64 bits
+    inline static thread_local uint64_t modulus = 2147483647;
+
+    /// @brief Residue, always in [0, modulus)
+    uint64_t value;
+
+    /// @brief Empty constructor
+    Modular() : value{0} {}
+
+    /// @brief Constructor from integer, negative values are wrapped
+    /// @param v Integer value
+    Modular(const int64_t &v)
+    {
+        const int64_t r = v % (int64_t)modulus;
+        value = r < 0 ? r + modulus : r;
+    }
+
+    /// @brief Sets current thread's modulus
+    /// @param p Prime modulus
+    static void setModulus(const uint64_t &p)
+    {
+        assert((p > 1 && p < (1ULL << 32)) && "Modulus must be between 2 and 2^32");
+        modulus = p;
+    }
+
+    /// @brief Raise to integer power
+    /// @param e Exponent
+    /// @return Result of exponentiation
+    Modular pow(uint64_t e) const
+    {
+        Modular base{*this};
+        Modular res{1};
+        while (e > 0)
+        {
+            if (e & 1)
+                res *= base;
+            base *= base;
+            e >>= 1;
+        }
+
+        return res;
+    }
+
+    /// @brief Get multiplicative inverse, by Fermat's little theorem
+    /// @return Inverse of value
+    Modular inverse() const
+    {
+        // Value can't be zero
+        assert((value != 0) && "Zero has no modular inverse");
+        return pow(modulus - 2);
+    }
+
+    /// @brief Equal check operator
+    /// @param m Value to check
+    /// @return Whether 2 values are the same
+    bool operator==(const Modular &m) const { return value == m.value; }
+
+    /// @brief Different check operator
+    /// @param m Value to check
+    /// @return Whether 2 values are different
+    bool operator!=(const Modular &m) const { return value != m.value; }
+
+    /// @brief Add value and assign
+    /// @param m Second value
+    /// @return Result of addition
+    Modular &operator+=(const Modular &m)
+    {
+        value += m.value;
+        if (value >= modulus)
+            value -= modulus;
+        return *this;
+    }
+
+    /// @brief Subtract value and assign
+    /// @param m Second value
+    /// @return Result of subtraction
+    Modular &operator-=(const Modular &m)
+    {
+        value += modulus - m.value;
+        if (value >= modulus)
+            value -= modulus;
+        return *this;
+    }
+
+    /// @brief Multiply value and assign
+    /// @param m Second value
+    /// @return Result of multiplication
+    Modular &operator*=(const Modular &m)
+    {
+        value = value * m.value % modulus;
+        return *this;
+    }
+
+    /// @brief Divide value and assign
+    /// @param m Second value
+    /// @return Result of division
+    Modular &operator/=(const Modular &m)
+    {
+        return *this *= m.inverse();
+    }
+
+    /// @brief Add value
+    /// @param m Second value
+    /// @return Result of addition
+    Modular operator+(const Modular &m) const { return Modular{*this} += m; }
+
+    /// @brief Subtract value
+    /// @param m Second value
+    /// @return Result of subtraction
+    Modular operator-(const Modular &m) const { return Modular{*this} -= m; }
+
+    /// @brief Multiply value
+    /// @param m Second value
+    /// @return Result of multiplication
+    Modular operator*(const Modular &m) const { return Modular{*this} *= m; }
+
+    /// @brief Divide value
+    /// @param m Second value
+    /// @return Result of division
+    Modular operator/(const Modular &m) const { return Modular{*this} /= m; }
+
+    /// @brief Negative operator
+    /// @return Additive inverse of value
+    Modular operator-() const { return Modular{} -= *this; }
+
+    /// @brief Print value
+    /// @param os ostream
+    /// @param m Value
+    /// @return Given stream with value
+    friend std::ostream &operator<<(std::ostream &os, const Modular &m)
+    {
+        return os << m.value;
+    }
+};
+
+/// @brief Sets the current thread's modulus for as long as it lives, restoring the previous one
+/// on exit, so helpers working under their own prime leave their caller's modulus untouched
+class ModulusScope
+{
+public:
+    /// @brief Switches the current thread to a new modulus
+    /// @param p Prime modulus
+    explicit ModulusScope(const uint64_t &p) : saved{Modular::modulus}
+    {
+        Modular::setModulus(p);
+    }
+
+    /// @brief Restores the previous modulus
+    ~ModulusScope()
+    {
+        Modular::modulus = saved;
+    }
+
+    ModulusScope(const ModulusScope &) = delete;
+    ModulusScope &operator=(const ModulusScope &) = delete;
+
+private:
+    uint64_t saved;
+};
+
+/// @brief Thread-local state a data type depends on, captured on the calling thread and entered
+/// by every task run on its behalf. Most types have none; Modular carries its modulus
+/// @tparam T Data type
+template <typename T>
+struct ThreadState
+{
+    /// @brief Scope entered by a task, doing nothing
+    struct Scope
+    {
+    };
+
+    /// @brief Enters the captured state on the current thread, for as long as the scope lives
+    Scope enter() const { return {}; }
+};
+
+template <>
+struct ThreadState<Modular>
+{
+    /// @brief Calling thread's modulus
+    uint64_t modulus = Modular::modulus;
+
+    /// @brief Switches the current thread to the captured modulus, for as long as the scope lives
+    ModulusScope enter() const { return ModulusScope{modulus}; }
+};
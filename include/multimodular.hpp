@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <include/fraction.hpp>
+#include <include/lu.hpp>
+#include <include/matrix.hpp>
+#include <include/modular.hpp>
+#include <include/thread_pool.hpp>
+
+/// @brief 31-bit primes used for multi-modular computations. The first ones are
+/// combined, and one extra is kept to verify the reconstructed result
+inline constexpr uint64_t multiModularPrimes[] = {
+    2147483647, 2147483629, 2147483587, 2147483579, 2147483563, 2147483549,
+    2147483543, 2147483497, 2147483489, 2147483477, 2147483423, 2147483399};
+
+/// @brief Number of primes combined by Chinese remaindering. Their product stays below 2^124,
+/// so reconstruction works in 128 bits and recovers fractions whose numerator and denominator
+/// fit in 61 bits; larger results can't be told apart from the residues and are reported as overflow
+inline constexpr size_t multiModularCombined = 4;
+
+/// @brief Maps a fraction to the current thread's modulus
+/// @param f Fraction, its denominator must not be a multiple of the modulus
+/// @return f.numerator / f.denominator modulo the current prime
+inline Modular toModular(const Fraction &f)
+{
+    return Modular{f.numerator} / Modular{f.denominator};
+}
+
+/// @brief Residues of a multi-modular computation
+/// @tparam N Number of residues produced under each prime
+template <size_t N>
+struct MultiModularResidues
+{
+    /// @brief Residues for each usable prime, in the order the primes were tried
+    std::vector<std::pair<uint64_t, std::array<uint64_t, N>>> residues;
+
+    /// @brief Unlucky primes, skipped because they divide some denominator or the computation failed under them
+    std::vector<uint64_t> unlucky;
+};
+
+/// @brief Chinese remaindering of one residue into an accumulated one. The current thread's
+/// modulus is left as it was
+/// @param x Residue modulo m, updated to residue modulo m * p
+/// @param m Accumulated modulus, updated to m * p
+/// @param r Residue modulo p
+/// @param p New prime
+inline void crtCombine(unsigned __int128 &x, unsigned __int128 &m, const uint64_t &r, const uint64_t &p)
+{
+    const ModulusScope scope{p};
+    const Modular t = (Modular{(int64_t)r} - Modular{(int64_t)(x % p)}) / Modular{(int64_t)(m % p)};
+    x += m * t.value;
+    m *= p;
+}
+
+/// @brief Rational reconstruction: finds a / b with |a|, b <= sqrt(m / 2) and a = x * b (mod m)
+/// Based on: https://en.wikipedia.org/wiki/Rational_reconstruction_(mathematics)
+/// @param x Residue modulo m
+/// @param m Modulus
+/// @param f Reconstructed fraction
+/// @return Whether a fraction within the bound exists
+inline bool rationalReconstruction(const unsigned __int128 &x, const unsigned __int128 &m, Fraction &f)
+{
+    // Integer square root of m / 2, corrected after the floating point estimate
+    unsigned __int128 bound = (unsigned __int128)std::sqrt((long double)(m / 2));
+    while (bound * bound > m / 2)
+        --bound;
+    while ((bound + 1) * (bound + 1) <= m / 2)
+        ++bound;
+
+    // Extended Euclid on (m, x), stopped once the remainder falls below the bound
+    __int128 r0 = m, r1 = x;
+    __int128 t0 = 0, t1 = 1;
+    while ((unsigned __int128)r1 > bound)
+    {
+        const __int128 q = r0 / r1;
+        __int128 tmp = r0 - q * r1;
+        r0 = r1;
+        r1 = tmp;
+        tmp = t0 - q * t1;
+        t0 = t1;
+        t1 = tmp;
+    }
+
+    if (t1 < 0)
+    {
+        r1 = -r1;
+        t1 = -t1;
+    }
+    if (t1 == 0 || (unsigned __int128)t1 > bound)
+        return false;
+
+    f = Fraction{(int64_t)r1, (int64_t)t1};
+    f.reduce();
+    return f.denominator == (int64_t)t1;
+}
+
+/// @brief Checks a reconstructed fraction against a residue modulo another prime. The current
+/// thread's modulus is left as it was
+/// @param f Reconstructed fraction
+/// @param r Expected residue
+/// @param p Prime
+/// @return Whether the fraction agrees with the residue
+inline bool checkResidue(const Fraction &f, const uint64_t &r, const uint64_t &p)
+{
+    const ModulusScope scope{p};
+    if (Modular{f.denominator} == Modular{0})
+        return false;
+    return toModular(f).value == r;
+}
+
+/// @brief Runs a computation under several primes on a thread pool, replacing primes
+/// that divide some denominator or for which the computation fails
+/// @tparam N Number of residues produced by the computation
+/// @param m Fraction matrix
+/// @param f Computation taking the matrix mapped to the current modulus, returns whether it succeeded;
+/// it must not print, failing is the expected outcome for an unlucky prime
+/// @param pool Thread pool
+/// @return Residues for each usable prime (enough to combine and verify, if that many primes worked),
+/// and the unlucky primes skipped on the way
+template <size_t R, size_t C, size_t N, typename F>
+MultiModularResidues<N> multiModularRun(const Matrix<R, C, Fraction> &m, F &&f, ThreadPool &pool)
+{
+    const auto run = [&m, &f](const uint64_t &p)
+    {
+        const ModulusScope scope{p};
+        std::pair<bool, std::array<uint64_t, N>> res{false, {}};
+
+        Matrix<R, C, Modular> mod{};
+        for (size_t i = 0; i < R; ++i)
+        {
+            for (size_t j = 0; j < C; ++j)
+            {
+                if (Modular{m.data[i][j].denominator} == Modular{0})
+                    return res;
+                mod.data[i][j] = toModular(m.data[i][j]);
+            }
+        }
+
+        res.first = f(mod, res.second);
+        return res;
+    };
+
+    // Keep enough usable primes to combine, plus one to verify
+    const size_t needed = multiModularCombined + 1;
+    const size_t available = sizeof(multiModularPrimes) / sizeof(multiModularPrimes[0]);
+
+    MultiModularResidues<N> res;
+    auto &residues = res.residues;
+    size_t next = 0;
+    while (residues.size() < needed && next < available)
+    {
+        // Only launch as many primes as are still missing
+        std::vector<std::pair<uint64_t, std::future<std::pair<bool, std::array<uint64_t, N>>>>> jobs;
+        for (size_t k = residues.size(); k < needed && next < available; ++k, ++next)
+        {
+            const uint64_t p = multiModularPrimes[next];
+            jobs.emplace_back(p, pool.submit([&run, p]
+                                             { return run(p); }));
+        }
+
+        for (auto &job : jobs)
+        {
+            auto done = job.second.get();
+            if (done.first)
+            {
+                residues.emplace_back(job.first, done.second);
+            }
+            else
+            {
+                res.unlucky.push_back(job.first);
+            }
+        }
+    }
+
+    return res;
+}
+
+/// @brief Reconstructs fractions from residues modulo several primes
+/// @param run Residues per prime, as returned by multiModularRun
+/// @param res Reconstructed fractions
+/// @return Whether every fraction was reconstructed and verified
+template <size_t N>
+bool multiModularReconstruct(const MultiModularResidues<N> &run, std::array<Fraction, N> &res)
+{
+    const auto &residues = run.residues;
+    if (residues.size() < multiModularCombined + 1)
+        return false;
+
+    for (size_t n = 0; n < N; ++n)
+    {
+        unsigned __int128 x = 0, m = 1;
+        for (size_t k = 0; k < multiModularCombined; ++k)
+        {
+            crtCombine(x, m, residues[k].second[n], residues[k].first);
+        }
+
+        const auto &check = residues[multiModularCombined];
+        if (!rationalReconstruction(x, m, res[n]) || !checkResidue(res[n], check.second[n], check.first))
+            return false;
+    }
+
+    return true;
+}
+
+/// @brief Calculates determinant of a fraction matrix modulo several primes in parallel,
+/// then reconstructs it by Chinese remaindering and rational reconstruction
+/// @param m Matrix
+/// @param pool Thread pool running one elimination per prime
+/// @return Matrix's determinant
+/// @throws std::overflow_error if the determinant's numerator or denominator doesn't fit in 61 bits
+template <size_t R, size_t C>
+Fraction multiModularDeterminant(const Matrix<R, C, Fraction> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    static_assert((R == C) && "Determinant is defined only for square matrices");
+
+    // A prime dividing the determinant gives a null residue, which reconstruction handles like any other
+    const auto residues = multiModularRun<R, C, 1>(
+        m, [](Matrix<R, C, Modular> &mod, std::array<uint64_t, 1> &res)
+        {
+            res[0] = LU<R, Modular>{mod}.determinant().value;
+            return true; },
+        pool);
+
+    std::array<Fraction, 1> det;
+    if (!multiModularReconstruct(residues, det))
+    {
+        throw std::overflow_error("Multi-modular determinant does not fit in 61-bit terms");
+    }
+
+    return det[0];
+}
+
+/// @brief Calculates inverse of a fraction matrix modulo several primes in parallel,
+/// then reconstructs it by Chinese remaindering and rational reconstruction
+/// @param m Matrix
+/// @param pool Thread pool running one elimination per prime
+/// @return Matrix's inverse, or a null matrix if it has no inverse
+/// @throws std::overflow_error if some cell's numerator or denominator doesn't fit in 61 bits
+template <size_t R, size_t C>
+Matrix<R, C, Fraction> multiModularInverse(const Matrix<R, C, Fraction> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    static_assert((R == C) && "Inverse of matrix is defined only for square matrices");
+
+    const auto residues = multiModularRun<R, C, R * C>(
+        m, [](Matrix<R, C, Modular> &mod, std::array<uint64_t, R * C> &res)
+        {
+            // A prime dividing the determinant can't invert the matrix
+            const LU<R, Modular> lu{mod};
+            if (lu.isSingular())
+                return false;
+
+            const auto inv = lu.inverse();
+
+            for (size_t i = 0; i < R; ++i)
+            {
+                for (size_t j = 0; j < C; ++j)
+                {
+                    res[i * C + j] = inv.data[i][j].value;
+                }
+            }
+            return true; },
+        pool);
+
+    // Every prime failing means the determinant is zero
+    if (residues.residues.empty())
+    {
+        printf("No inverse: determinant is null\n\n");
+        return Matrix<R, C, Fraction>();
+    }
+
+    std::array<Fraction, R * C> cells;
+    if (!multiModularReconstruct(residues, cells))
+    {
+        throw std::overflow_error("Multi-modular inverse does not fit in 61-bit terms");
+    }
+
+    Matrix<R, C, Fraction> res{};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            res.data[i][j] = cells[i * C + j];
+        }
+    }
+
+    return res;
+}
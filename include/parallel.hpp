@@ -0,0 +1,306 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <type_traits>
+
+#include <include/dyn_matrix.hpp>
+#include <include/fraction.hpp>
+#include <include/gemm.hpp>
+#include <include/matrix.hpp>
+#include <include/modular.hpp>
+#include <include/thread_pool.hpp>
+
+// Multithreaded matrix product, inverse and determinant. Each function takes the
+// pool to run on, the library's shared pool by default; its size is set with the
+// MATRIX_THREADS environment variable. Small inputs run on the calling thread only.
+// Chunks run under the caller's thread-local state, so Modular matrices work
+// modulo the caller's modulus on every worker
+
+/// @brief Fewest rows per parallel chunk, so that scheduling a chunk costs little next to running it
+/// @tparam T Cell type, arithmetic cells are far cheaper than Fraction or BigFraction ones
+/// @param cellsPerRow Cells touched per row of the chunk
+/// @return Rows per chunk
+template <typename T>
+size_t parallelGrain(const size_t &cellsPerRow)
+{
+    const size_t cells = std::is_arithmetic_v<T> ? 1 << 14 : 1 << 8;
+    if (cellsPerRow == 0)
+        return cells;
+
+    return cellsPerRow >= cells ? 1 : cells / cellsPerRow;
+}
+
+/// @brief Product of 2 matrices, split in tiles of the result computed in parallel
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @param pool Thread pool
+/// @return Result of product
+template <typename T>
+DynMatrix<T> parallelProduct(const DynMatrix<T> &m0, const DynMatrix<T> &m1, ThreadPool &pool = ThreadPool::shared())
+{
+    assert((m0.cols() == m1.rows()) && "Left matrix's columns must match right matrix's rows");
+
+    const size_t rows = m0.rows();
+    const size_t inner = m0.cols();
+    const size_t cols = m1.cols();
+    DynMatrix<T> res{rows, cols};
+
+    // Empty product, or null from an empty inner order; there are no tiles to split
+    if (rows == 0 || cols == 0 || inner == 0)
+        return res;
+
+    if constexpr (hasGemm<T>)
+    {
+        // Tiles are one packed block of A tall, and narrow enough to give every worker a few.
+        // Each tile packs its own B panels, trading some repeated packing for no synchronization
+        const size_t tileRows = GemmKernel<T>::MC;
+        const size_t rowTiles = (rows + tileRows - 1) / tileRows;
+        const size_t wanted = 4 * (pool.size() + 1);
+        const size_t colTiles = (wanted + rowTiles - 1) / rowTiles;
+        size_t tileCols = (cols + colTiles - 1) / colTiles;
+        tileCols = (tileCols + GemmKernel<T>::NR - 1) / GemmKernel<T>::NR * GemmKernel<T>::NR;
+        if (tileCols < 64)
+            tileCols = 64;
+        const size_t tilesPerRow = (cols + tileCols - 1) / tileCols;
+
+        // One tile is work enough to be worth a task
+        const size_t grain = tileRows * tileCols * inner >= gemmThreshold ? 1 : rowTiles * tilesPerRow;
+        pool.parallelFor(0, rowTiles * tilesPerRow, grain, [&](const size_t &t0, const size_t &t1)
+                         {
+            for (size_t t = t0; t < t1; ++t)
+            {
+                const size_t i = t / tilesPerRow * tileRows;
+                const size_t j = t % tilesPerRow * tileCols;
+                const size_t m = rows - i < tileRows ? rows - i : tileRows;
+                const size_t n = cols - j < tileCols ? cols - j : tileCols;
+                gemm(m, n, inner, m0[i], m0.stride(), m1[0] + j, m1.stride(), res[i] + j, res.stride());
+            } });
+
+        return res;
+    }
+
+    const ThreadState<T> state;
+    pool.parallelFor(0, rows, parallelGrain<T>(inner * cols), [&](const size_t &i0, const size_t &i1)
+                     {
+        [[maybe_unused]] const auto scope = state.enter();
+        for (size_t i = i0; i < i1; ++i)
+        {
+            const T *a = m0[i];
+            T *out = res[i];
+
+            // Fractions accumulate over a common denominator and reduce once per cell
+            if constexpr (std::is_same_v<T, Fraction>)
+            {
+                for (size_t j = 0; j < cols; ++j)
+                    out[j] = dotProduct(a, 1, m1[0] + j, m1.stride(), inner);
+                continue;
+            }
+
+            for (size_t k = 0; k < inner; ++k)
+            {
+                const T *b = m1[k];
+                for (size_t j = 0; j < cols; ++j)
+                    multiplyAdd(out[j], a[k], b[j]);
+            }
+        } });
+
+    return res;
+}
+
+/// @brief Product of 2 matrices, split in tiles of the result computed in parallel
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @param pool Thread pool
+/// @return Result of product
+template <size_t R, size_t M, size_t C, typename T>
+Matrix<R, C, T> parallelProduct(const Matrix<R, M, T> &m0, const Matrix<M, C, T> &m1, ThreadPool &pool = ThreadPool::shared())
+{
+    return parallelProduct(DynMatrix<T>{m0}, DynMatrix<T>{m1}, pool).template toMatrix<R, C>();
+}
+
+/// @brief Calculates matrix inverse by Gauss-Jordan elimination, updating the rows of
+/// each pivot column in parallel
+/// @param m Matrix
+/// @param pool Thread pool
+/// @return Matrix's inverse, or an empty matrix if it has no inverse
+template <typename T>
+DynMatrix<T> parallelGaussJordanInverse(const DynMatrix<T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    assert((m.rows() == m.cols()) && "Inverse of matrix is defined only for square matrices");
+
+    const size_t o = m.rows();
+
+    // Create matrix of order (o, 2o)
+    // Left side is current matrix, right side is identity
+    DynMatrix<T> inv{o, 2 * o};
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            inv[i][j] = m[i][j];
+        }
+        inv[i][i + o] = T{1};
+    }
+
+    const size_t grain = parallelGrain<T>(2 * o);
+    const ThreadState<T> state;
+    for (size_t c = 0; c < o; ++c)
+    {
+        // Find first nonzero row
+        size_t row = -1;
+        for (size_t i = c; i < o; ++i)
+        {
+            if (inv[i][c] != T{0})
+            {
+                row = i;
+                break;
+            }
+        }
+        if (row == -1UL)
+        {
+            // Entire column is zero, can't reach identity
+            printf("No inverse: reached a state where column %ld is null\n\n", c);
+            return DynMatrix<T>();
+        }
+
+        if (row != c)
+        {
+            inv.swapRows(row, c);
+        }
+
+        // Make sure row[c] is 1
+        const T pivot = inv[c][c];
+        if (pivot != T{1})
+        {
+            inv.multiplyRow(c, T{1} / pivot);
+        }
+
+        // Every other row only reads the pivot row, so they can be updated concurrently
+        pool.parallelFor(0, o, grain, [&](const size_t &i0, const size_t &i1)
+                         {
+            [[maybe_unused]] const auto scope = state.enter();
+            for (size_t i = i0; i < i1; ++i)
+            {
+                if (i == c)
+                    continue;
+
+                const T elem = inv[i][c];
+                if (elem == T{0})
+                    continue;
+
+                inv.addScaledRow(i, c, -elem);
+            } });
+    }
+
+    // Create matrix using only right side of result
+    DynMatrix<T> res{o, o};
+    for (size_t i = 0; i < o; ++i)
+    {
+        for (size_t j = 0; j < o; ++j)
+        {
+            res[i][j] = inv[i][j + o];
+        }
+    }
+
+    return res;
+}
+
+/// @brief Calculates matrix inverse by Gauss-Jordan elimination, updating the rows of
+/// each pivot column in parallel
+/// @param m Matrix
+/// @param pool Thread pool
+/// @return Matrix's inverse, or an empty matrix if it has no inverse
+template <size_t R, size_t C, typename T>
+Matrix<R, C, T> parallelGaussJordanInverse(const Matrix<R, C, T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    static_assert((R == C) && "Inverse of matrix is defined only for square matrices");
+
+    const DynMatrix<T> inv = parallelGaussJordanInverse(DynMatrix<T>{m}, pool);
+    if (inv.rows() == 0)
+        return Matrix<R, C, T>();
+
+    return inv.template toMatrix<R, C>();
+}
+
+/// @brief Calculates matrix determinant by Gaussian elimination, updating the rows below
+/// each pivot in parallel
+/// @param m Matrix
+/// @param pool Thread pool
+/// @return Matrix's determinant
+template <typename T>
+T parallelRowReductionDeterminant(const DynMatrix<T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    assert((m.rows() == m.cols()) && "Determinant is defined only for square matrices");
+
+    const size_t o = m.rows();
+    DynMatrix<T> tmp{m};
+
+    // Save determinant scale
+    T scale = T{1};
+
+    const size_t grain = parallelGrain<T>(o);
+    const ThreadState<T> state;
+    for (size_t c = 0; c < o; ++c)
+    {
+        // Find first nonzero row
+        size_t row = -1;
+        for (size_t i = c; i < o; ++i)
+        {
+            if (tmp[i][c] != T{0})
+            {
+                row = i;
+                break;
+            }
+        }
+        if (row == -1UL)
+        {
+            // Entire column is zero, can't reach identity
+            printf("No inverse: reached a state where column %ld is null\n\n", c);
+            return T{0};
+        }
+
+        // Swapping rows flips the determinant's sign
+        if (row != c)
+        {
+            tmp.swapRows(row, c);
+            scale *= T{-1};
+        }
+
+        // Make sure row[c] is 1
+        T rowScale = tmp[c][c];
+        if (rowScale != T{1})
+        {
+            tmp.multiplyRow(c, T{1} / rowScale);
+            scale *= rowScale;
+        }
+
+        // Rows below the pivot only read the pivot row, so they can be updated concurrently
+        pool.parallelFor(c + 1, o, grain, [&](const size_t &i0, const size_t &i1)
+                         {
+            [[maybe_unused]] const auto scope = state.enter();
+            for (size_t i = i0; i < i1; ++i)
+            {
+                const T elem = tmp[i][c];
+                if (elem == T{0})
+                    continue;
+
+                tmp.addScaledRow(i, c, -elem);
+            } });
+    }
+
+    return scale;
+}
+
+/// @brief Calculates matrix determinant by Gaussian elimination, updating the rows below
+/// each pivot in parallel
+/// @param m Matrix
+/// @param pool Thread pool
+/// @return Matrix's determinant
+template <size_t R, size_t C, typename T>
+T parallelRowReductionDeterminant(const Matrix<R, C, T> &m, ThreadPool &pool = ThreadPool::shared())
+{
+    static_assert((R == C) && "Determinant is defined only for square matrices");
+
+    return parallelRowReductionDeterminant(DynMatrix<T>{m}, pool);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdlib>
+#include <array>
+#include <utility>
+
+template <size_t R, size_t C, typename T>
+class Matrix;
+
+/// @brief Row permutation of an N-row matrix. Eliminations address rows through it, so
+/// swapping two rows swaps two indices instead of two rows of cells
+/// @tparam N Number of rows
+template <size_t N>
+class Permutation
+{
+public:
+    /// @brief Identity permutation
+    Permutation();
+
+    /// @brief Row of the original matrix at a position
+    /// @param i Position
+    /// @return Original row index
+    const size_t &operator[](const size_t &i) const;
+
+    /// @brief Swaps the rows at two positions, in O(1)
+    /// @param i First position
+    /// @param j Second position
+    void swap(const size_t &i, const size_t &j);
+
+    /// @brief Whether the permutation is made of an odd number of swaps
+    bool isOdd() const;
+
+    /// @brief Sign of the permutation, as a determinant factor
+    /// @return -1 if odd, 1 otherwise
+    template <typename T>
+    T sign() const;
+
+    /// @brief Inverse permutation
+    /// @return Permutation undoing this one
+    Permutation<N> inverse() const;
+
+    /// @brief Reorders the rows of a matrix, P * m
+    /// @param m Matrix
+    /// @return Matrix whose row i is row (*this)[i] of m
+    template <size_t C, typename T>
+    Matrix<N, C, T> apply(const Matrix<N, C, T> &m) const;
+
+    /// @brief Permutation matrix P
+    /// @return Matrix with a single 1 on every row
+    template <typename T>
+    Matrix<N, N, T> toMatrix() const;
+
+private:
+    std::array<size_t, N> index;
+    bool odd = false;
+};
+
+template <size_t N>
+Permutation<N>::Permutation()
+{
+    for (size_t i = 0; i < N; ++i)
+        index[i] = i;
+}
+
+template <size_t N>
+const size_t &Permutation<N>::operator[](const size_t &i) const
+{
+    return index[i];
+}
+
+template <size_t N>
+void Permutation<N>::swap(const size_t &i, const size_t &j)
+{
+    if (i == j)
+        return;
+
+    std::swap(index[i], index[j]);
+    odd = !odd;
+}
+
+template <size_t N>
+bool Permutation<N>::isOdd() const
+{
+    return odd;
+}
+
+template <size_t N>
+template <typename T>
+T Permutation<N>::sign() const
+{
+    return odd ? T{-1} : T{1};
+}
+
+template <size_t N>
+Permutation<N> Permutation<N>::inverse() const
+{
+    Permutation<N> inv;
+    for (size_t i = 0; i < N; ++i)
+        inv.index[index[i]] = i;
+    inv.odd = odd;
+
+    return inv;
+}
+
+template <size_t N>
+template <size_t C, typename T>
+Matrix<N, C, T> Permutation<N>::apply(const Matrix<N, C, T> &m) const
+{
+    Matrix<N, C, T> res{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            res.data[i][j] = m.data[index[i]][j];
+        }
+    }
+
+    return res;
+}
+
+template <size_t N>
+template <typename T>
+Matrix<N, N, T> Permutation<N>::toMatrix() const
+{
+    Matrix<N, N, T> res{};
+    for (size_t i = 0; i < N; ++i)
+        res.data[i][index[i]] = T{1};
+
+    return res;
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+// Vectorized element-wise kernels for float, double, int32_t and int64_t cells.
+//
+// Each kernel is written once with GCC vector extensions and compiled for
+// several vector widths: 16 bytes (SSE2, or whatever the target's baseline
+// vector unit is), and on x86 also 32 bytes under target("avx2") and
+// 64 bytes under target("avx512f"). The widest version the CPU supports is
+// picked at run time from CPUID, so one binary runs the AVX-512 kernels on
+// hosts that have them without requiring AVX2 anywhere else
+
+/// @brief Whether a cell type has vectorized element-wise kernels
+template <typename T>
+constexpr bool hasSimd = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                         std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>;
+
+/// @brief Fewest cells for which matrix operations call the kernels. Shorter runs are
+/// left to the compiler, since dispatching costs more than it saves
+constexpr size_t simdMinimumCells = 16;
+
+/// @brief Vector instruction sets the kernels are compiled for
+enum class SimdLevel
+{
+    baseline,
+    avx2,
+    avx512
+};
+
+/// @brief Widest instruction set supported by this CPU, detected once
+/// @return Instruction set used by the kernels
+inline SimdLevel simdLevel()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    static const SimdLevel level = []
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return SimdLevel::avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::avx2;
+        return SimdLevel::baseline;
+    }();
+    return level;
+#else
+    return SimdLevel::baseline;
+#endif
+}
+
+/// @brief Name of an instruction set
+/// @param level Instruction set
+/// @return Printable name
+inline const char *simdLevelName(const SimdLevel &level)
+{
+    switch (level)
+    {
+    case SimdLevel::avx512:
+        return "avx512f";
+    case SimdLevel::avx2:
+        return "avx2";
+    default:
+        return "baseline";
+    }
+}
+
+/// @brief Element-wise operations implemented by the kernels
+enum class SimdOp
+{
+    add,             // dst += src
+    subtract,        // dst -= src
+    reverseSubtract, // dst = src - dst
+    negate,          // dst = -dst
+    scale,           // dst *= s
+    addScaled,       // dst += s * src
+    swap             // dst <-> src
+};
+
+/// @brief Applies an operation over n cells with W-byte vectors, the tail one cell at a time.
+/// Always inlined, so it compiles for the instruction set of the function it is called from
+template <size_t W, SimdOp Op, typename T>
+__attribute__((always_inline)) inline void simdLoop(T *dst, T *src, const T &s, const size_t &n)
+{
+    typedef T Vec __attribute__((vector_size(W)));
+    constexpr size_t lanes = W / sizeof(T);
+
+    // Local copies, so stores to dst can't alias them and force reloads
+    const size_t count = n;
+    const T scalar = s;
+
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes)
+    {
+        Vec d, x;
+        memcpy(&d, dst + i, W);
+        if constexpr (Op != SimdOp::negate && Op != SimdOp::scale)
+            memcpy(&x, src + i, W);
+
+        if constexpr (Op == SimdOp::add)
+            d += x;
+        else if constexpr (Op == SimdOp::subtract)
+            d -= x;
+        else if constexpr (Op == SimdOp::reverseSubtract)
+            d = x - d;
+        else if constexpr (Op == SimdOp::negate)
+            d = -d;
+        else if constexpr (Op == SimdOp::scale)
+            d *= scalar;
+        else if constexpr (Op == SimdOp::addScaled)
+            d += scalar * x;
+        else
+            memcpy(src + i, &d, W);
+
+        memcpy(dst + i, Op == SimdOp::swap ? &x : &d, W);
+    }
+
+    for (; i < count; ++i)
+    {
+        if constexpr (Op == SimdOp::add)
+            dst[i] += src[i];
+        else if constexpr (Op == SimdOp::subtract)
+            dst[i] -= src[i];
+        else if constexpr (Op == SimdOp::reverseSubtract)
+            dst[i] = src[i] - dst[i];
+        else if constexpr (Op == SimdOp::negate)
+            dst[i] = -dst[i];
+        else if constexpr (Op == SimdOp::scale)
+            dst[i] *= scalar;
+        else if constexpr (Op == SimdOp::addScaled)
+            dst[i] += scalar * src[i];
+        else
+        {
+            const T tmp = dst[i];
+            dst[i] = src[i];
+            src[i] = tmp;
+        }
+    }
+}
+
+/// @brief Kernel for the baseline instruction set
+template <SimdOp Op, typename T>
+void simdBaseline(T *dst, T *src, const T &s, const size_t &n)
+{
+    simdLoop<16, Op>(dst, src, s, n);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/// @brief Kernel for AVX2 hosts
+template <SimdOp Op, typename T>
+__attribute__((target("avx2"))) void simdAvx2(T *dst, T *src, const T &s, const size_t &n)
+{
+    simdLoop<32, Op>(dst, src, s, n);
+}
+
+/// @brief Kernel for AVX-512 hosts
+template <SimdOp Op, typename T>
+__attribute__((target("avx512f"))) void simdAvx512(T *dst, T *src, const T &s, const size_t &n)
+{
+    simdLoop<64, Op>(dst, src, s, n);
+}
+#endif
+
+/// @brief Runs an operation with the widest kernel the CPU supports
+/// @param dst Cells written by the operation
+/// @param src Cells read by the operation, written only by swap. Unused by negate and scale
+/// @param s Scalar, used by scale and addScaled
+/// @param n Number of cells
+template <SimdOp Op, typename T>
+void simdApply(T *dst, T *src, const T &s, const size_t &n)
+{
+    static_assert(hasSimd<T>, "No vectorized kernels for this type");
+
+#if defined(__x86_64__) || defined(__i386__)
+    switch (simdLevel())
+    {
+    case SimdLevel::avx512:
+        return simdAvx512<Op>(dst, src, s, n);
+    case SimdLevel::avx2:
+        return simdAvx2<Op>(dst, src, s, n);
+    default:
+        break;
+    }
+#endif
+    simdBaseline<Op>(dst, src, s, n);
+}
+
+/// @brief dst[i] += src[i]
+template <typename T>
+void simdAdd(T *dst, const T *src, const size_t &n)
+{
+    // src is only written by swap
+    simdApply<SimdOp::add>(dst, const_cast<T *>(src), T{0}, n);
+}
+
+/// @brief dst[i] -= src[i]
+template <typename T>
+void simdSubtract(T *dst, const T *src, const size_t &n)
+{
+    simdApply<SimdOp::subtract>(dst, const_cast<T *>(src), T{0}, n);
+}
+
+/// @brief dst[i] = src[i] - dst[i]
+template <typename T>
+void simdReverseSubtract(T *dst, const T *src, const size_t &n)
+{
+    simdApply<SimdOp::reverseSubtract>(dst, const_cast<T *>(src), T{0}, n);
+}
+
+/// @brief dst[i] = -dst[i]
+template <typename T>
+void simdNegate(T *dst, const size_t &n)
+{
+    simdApply<SimdOp::negate>(dst, dst, T{0}, n);
+}
+
+/// @brief dst[i] *= s
+template <typename T>
+void simdScale(T *dst, const T &s, const size_t &n)
+{
+    simdApply<SimdOp::scale>(dst, dst, s, n);
+}
+
+/// @brief dst[i] += s * src[i]
+template <typename T>
+void simdAddScaled(T *dst, const T *src, const T &s, const size_t &n)
+{
+    simdApply<SimdOp::addScaled>(dst, const_cast<T *>(src), s, n);
+}
+
+/// @brief Swaps dst[i] and src[i]
+template <typename T>
+void simdSwap(T *a, T *b, const size_t &n)
+{
+    simdApply<SimdOp::swap>(a, b, T{0}, n);
+}
@@ -0,0 +1,466 @@
+#pragma once
+
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <include/dyn_matrix.hpp>
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+
+// Compressed sparse row (CSR) storage: the column indices and values of every
+// nonzero, row after row, with offsets()[i] the position of row i's first
+// nonzero. Column indices are strictly increasing within a row and no stored
+// value is zero, so memory and the cost of every operation scale with the
+// nonzeros rather than with rows * columns.
+//
+// The compressed sparse column (CSC) arrays of a matrix are the CSR arrays of
+// its transpose, which transpose() builds by a counting sort in O(nonzeros);
+// column-oriented algorithms such as SparseLU take them from there
+
+/// @brief Nonzero of a sparse matrix given by coordinates
+/// @tparam T Matrix data type
+template <typename T>
+struct SparseEntry
+{
+    size_t row;
+    size_t col;
+    T value;
+};
+
+/// @brief Sparse matrix in compressed sparse row form
+/// @tparam T Matrix data type
+template <typename T>
+class SparseMatrix
+{
+public:
+    /// @brief Empty matrix, with no rows or columns
+    SparseMatrix();
+
+    /// @brief Null matrix
+    /// @param r Number of rows
+    /// @param c Number of columns
+    SparseMatrix(const size_t &r, const size_t &c);
+
+    /// @brief Takes compressed sparse row arrays as they are
+    /// @param r Number of rows
+    /// @param c Number of columns
+    /// @param offsets Position of each row's first nonzero, followed by the number of nonzeros
+    /// @param indices Column of each nonzero, increasing within a row
+    /// @param values Value of each nonzero
+    SparseMatrix(const size_t &r, const size_t &c, std::vector<size_t> offsets, std::vector<size_t> indices, std::vector<T> values);
+
+    /// @brief Builds a matrix from coordinates, in any order. Repeated coordinates are summed,
+    /// and cells summing to zero are not stored
+    /// @param r Number of rows
+    /// @param c Number of columns
+    /// @param entries Nonzeros
+    SparseMatrix(const size_t &r, const size_t &c, const std::vector<SparseEntry<T>> &entries);
+
+    /// @brief Keeps the nonzero cells of a dense matrix
+    /// @param m Matrix
+    explicit SparseMatrix(const DynMatrix<T> &m);
+
+    /// @brief Keeps the nonzero cells of a fixed-size matrix
+    /// @param m Matrix
+    template <size_t R, size_t C>
+    explicit SparseMatrix(const Matrix<R, C, T> &m);
+
+    /// @brief Number of rows
+    size_t rows() const;
+
+    /// @brief Number of columns
+    size_t cols() const;
+
+    /// @brief Number of stored nonzeros
+    size_t nonZeros() const;
+
+    /// @brief Position of each row's first nonzero in indices() and values(), rows() + 1 entries
+    const std::vector<size_t> &offsets() const;
+
+    /// @brief Column of each nonzero
+    const std::vector<size_t> &indices() const;
+
+    /// @brief Value of each nonzero
+    const std::vector<T> &values() const;
+
+    /// @brief Value of a cell, by binary search in its row
+    /// @param r Row
+    /// @param c Column
+    /// @return Cell's value, zero if it is not stored
+    T at(const size_t &r, const size_t &c) const;
+
+    /// @brief Transpose, in O(nonzeros). Its arrays are this matrix's compressed sparse columns
+    /// @return Transposed matrix
+    SparseMatrix<T> transpose() const;
+
+    /// @brief Dense copy
+    /// @return Matrix with every cell
+    DynMatrix<T> toDense() const;
+
+    /// @brief Product of this matrix by a vector
+    /// @param v Vector, with cols() entries
+    /// @return Result of product, with rows() entries
+    std::vector<T> operator*(const std::vector<T> &v) const;
+
+    /// @brief In-place product with scalar
+    /// @param s Scalar value
+    /// @return This matrix
+    SparseMatrix<T> &operator*=(const T &s);
+
+private:
+    size_t nRows = 0;
+    size_t nCols = 0;
+    std::vector<size_t> rowStart;
+    std::vector<size_t> colIndex;
+    std::vector<T> cells;
+};
+
+/// @brief Product of 2 sparse matrices, by rows of the right matrix combined per nonzero of the left (Gustavson)
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of product
+template <typename T>
+SparseMatrix<T> operator*(const SparseMatrix<T> &m0, const SparseMatrix<T> &m1);
+
+/// @brief Product of a sparse matrix and a dense matrix
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of product
+template <typename T>
+DynMatrix<T> operator*(const SparseMatrix<T> &m0, const DynMatrix<T> &m1);
+
+/// @brief Product of a dense matrix and a sparse matrix
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @return Result of product
+template <typename T>
+DynMatrix<T> operator*(const DynMatrix<T> &m0, const SparseMatrix<T> &m1);
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix() : rowStart(1, 0)
+{
+}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(const size_t &r, const size_t &c) : nRows{r}, nCols{c}, rowStart(r + 1, 0)
+{
+}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(const size_t &r, const size_t &c, std::vector<size_t> offsets, std::vector<size_t> indices, std::vector<T> values)
+    : nRows{r}, nCols{c}, rowStart{std::move(offsets)}, colIndex{std::move(indices)}, cells{std::move(values)}
+{
+    assert((rowStart.size() == r + 1) && "Offsets must have one entry per row, plus one");
+    assert((colIndex.size() == rowStart[r] && cells.size() == rowStart[r]) && "Indices and values must have one entry per nonzero");
+}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(const size_t &r, const size_t &c, const std::vector<SparseEntry<T>> &entries)
+    : nRows{r}, nCols{c}, rowStart(r + 1, 0)
+{
+    // Counting sort by row
+    for (const SparseEntry<T> &e : entries)
+    {
+        assert((e.row < r && e.col < c) && "Entry out of range");
+        ++rowStart[e.row + 1];
+    }
+    for (size_t i = 0; i < r; ++i)
+        rowStart[i + 1] += rowStart[i];
+
+    std::vector<size_t> next(rowStart.begin(), rowStart.end() - 1);
+    std::vector<std::pair<size_t, T>> sorted(entries.size());
+    for (const SparseEntry<T> &e : entries)
+        sorted[next[e.row]++] = {e.col, e.value};
+
+    // Sort each row by column, summing repeated columns and dropping zeros
+    colIndex.reserve(entries.size());
+    cells.reserve(entries.size());
+    size_t start = 0;
+    for (size_t i = 0; i < r; ++i)
+    {
+        const size_t end = rowStart[i + 1];
+        std::sort(sorted.begin() + start, sorted.begin() + end, [](const std::pair<size_t, T> &a, const std::pair<size_t, T> &b)
+                  { return a.first < b.first; });
+
+        rowStart[i] = colIndex.size();
+        for (size_t p = start; p < end;)
+        {
+            const size_t col = sorted[p].first;
+            T sum = sorted[p++].second;
+            while (p < end && sorted[p].first == col)
+                sum += sorted[p++].second;
+
+            if (sum == T{0})
+                continue;
+
+            colIndex.push_back(col);
+            cells.push_back(sum);
+        }
+        start = end;
+    }
+    rowStart[r] = colIndex.size();
+}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(const DynMatrix<T> &m) : nRows{m.rows()}, nCols{m.cols()}, rowStart(m.rows() + 1, 0)
+{
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        const T *row = m[i];
+        for (size_t j = 0; j < nCols; ++j)
+        {
+            if (row[j] == T{0})
+                continue;
+
+            colIndex.push_back(j);
+            cells.push_back(row[j]);
+        }
+        rowStart[i + 1] = colIndex.size();
+    }
+}
+
+template <typename T>
+template <size_t R, size_t C>
+SparseMatrix<T>::SparseMatrix(const Matrix<R, C, T> &m) : nRows{R}, nCols{C}, rowStart(R + 1, 0)
+{
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < C; ++j)
+        {
+            if (m.data[i][j] == T{0})
+                continue;
+
+            colIndex.push_back(j);
+            cells.push_back(m.data[i][j]);
+        }
+        rowStart[i + 1] = colIndex.size();
+    }
+}
+
+template <typename T>
+size_t SparseMatrix<T>::rows() const
+{
+    return nRows;
+}
+
+template <typename T>
+size_t SparseMatrix<T>::cols() const
+{
+    return nCols;
+}
+
+template <typename T>
+size_t SparseMatrix<T>::nonZeros() const
+{
+    return cells.size();
+}
+
+template <typename T>
+const std::vector<size_t> &SparseMatrix<T>::offsets() const
+{
+    return rowStart;
+}
+
+template <typename T>
+const std::vector<size_t> &SparseMatrix<T>::indices() const
+{
+    return colIndex;
+}
+
+template <typename T>
+const std::vector<T> &SparseMatrix<T>::values() const
+{
+    return cells;
+}
+
+template <typename T>
+T SparseMatrix<T>::at(const size_t &r, const size_t &c) const
+{
+    assert((r < nRows && c < nCols) && "Cell out of range");
+
+    const auto begin = colIndex.begin() + rowStart[r];
+    const auto end = colIndex.begin() + rowStart[r + 1];
+    const auto it = std::lower_bound(begin, end, c);
+    if (it == end || *it != c)
+        return T{0};
+
+    return cells[it - colIndex.begin()];
+}
+
+template <typename T>
+SparseMatrix<T> SparseMatrix<T>::transpose() const
+{
+    // Counting sort by column; walking rows in order leaves each new row sorted
+    std::vector<size_t> offsets(nCols + 1, 0);
+    for (const size_t &j : colIndex)
+        ++offsets[j + 1];
+    for (size_t j = 0; j < nCols; ++j)
+        offsets[j + 1] += offsets[j];
+
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    std::vector<size_t> indices(cells.size());
+    std::vector<T> values(cells.size());
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        for (size_t p = rowStart[i]; p < rowStart[i + 1]; ++p)
+        {
+            const size_t q = next[colIndex[p]]++;
+            indices[q] = i;
+            values[q] = cells[p];
+        }
+    }
+
+    return SparseMatrix<T>{nCols, nRows, std::move(offsets), std::move(indices), std::move(values)};
+}
+
+template <typename T>
+DynMatrix<T> SparseMatrix<T>::toDense() const
+{
+    DynMatrix<T> res{nRows, nCols};
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        T *row = res[i];
+        for (size_t p = rowStart[i]; p < rowStart[i + 1]; ++p)
+            row[colIndex[p]] = cells[p];
+    }
+
+    return res;
+}
+
+template <typename T>
+std::vector<T> SparseMatrix<T>::operator*(const std::vector<T> &v) const
+{
+    assert((v.size() == nCols) && "Vector's size must match matrix's columns");
+
+    std::vector<T> res(nRows, T{0});
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        for (size_t p = rowStart[i]; p < rowStart[i + 1]; ++p)
+            multiplyAdd(res[i], cells[p], v[colIndex[p]]);
+    }
+
+    return res;
+}
+
+template <typename T>
+SparseMatrix<T> &SparseMatrix<T>::operator*=(const T &s)
+{
+    if (s == T{0})
+    {
+        *this = SparseMatrix<T>{nRows, nCols};
+        return *this;
+    }
+
+    for (T &v : cells)
+        v *= s;
+
+    return *this;
+}
+
+template <typename T>
+SparseMatrix<T> operator*(const SparseMatrix<T> &m0, const SparseMatrix<T> &m1)
+{
+    assert((m0.cols() == m1.rows()) && "Left matrix's columns must match right matrix's rows");
+
+    const std::vector<size_t> &ap = m0.offsets(), &ai = m0.indices(), &bp = m1.offsets(), &bi = m1.indices();
+    const std::vector<T> &ax = m0.values(), &bx = m1.values();
+
+    std::vector<size_t> offsets(m0.rows() + 1, 0);
+    std::vector<size_t> indices;
+    std::vector<T> values;
+
+    // Dense accumulator over one row of the result; mark[j] tells which row last touched column j
+    std::vector<T> acc(m1.cols(), T{0});
+    std::vector<size_t> mark(m1.cols(), -1);
+    std::vector<size_t> pattern;
+    for (size_t i = 0; i < m0.rows(); ++i)
+    {
+        pattern.clear();
+        for (size_t p = ap[i]; p < ap[i + 1]; ++p)
+        {
+            const size_t k = ai[p];
+            const T &a = ax[p];
+            for (size_t q = bp[k]; q < bp[k + 1]; ++q)
+            {
+                const size_t j = bi[q];
+                if (mark[j] != i)
+                {
+                    mark[j] = i;
+                    pattern.push_back(j);
+                    acc[j] = T{0};
+                }
+                multiplyAdd(acc[j], a, bx[q]);
+            }
+        }
+
+        std::sort(pattern.begin(), pattern.end());
+        for (const size_t &j : pattern)
+        {
+            // Cancellation can leave a zero, which is not stored
+            if (acc[j] == T{0})
+                continue;
+
+            indices.push_back(j);
+            values.push_back(acc[j]);
+        }
+        offsets[i + 1] = indices.size();
+    }
+
+    return SparseMatrix<T>{m0.rows(), m1.cols(), std::move(offsets), std::move(indices), std::move(values)};
+}
+
+template <typename T>
+DynMatrix<T> operator*(const SparseMatrix<T> &m0, const DynMatrix<T> &m1)
+{
+    assert((m0.cols() == m1.rows()) && "Left matrix's columns must match right matrix's rows");
+
+    const std::vector<size_t> &ap = m0.offsets(), &ai = m0.indices();
+    const std::vector<T> &ax = m0.values();
+
+    // Each nonzero scales one dense row into the result's row
+    DynMatrix<T> res{m0.rows(), m1.cols()};
+    const size_t n = m1.cols();
+    for (size_t i = 0; i < m0.rows(); ++i)
+    {
+        T *out = res[i];
+        for (size_t p = ap[i]; p < ap[i + 1]; ++p)
+        {
+            const T *row = m1[ai[p]];
+            const T &a = ax[p];
+            for (size_t j = 0; j < n; ++j)
+                multiplyAdd(out[j], a, row[j]);
+        }
+    }
+
+    return res;
+}
+
+template <typename T>
+DynMatrix<T> operator*(const DynMatrix<T> &m0, const SparseMatrix<T> &m1)
+{
+    assert((m0.cols() == m1.rows()) && "Left matrix's columns must match right matrix's rows");
+
+    const std::vector<size_t> &bp = m1.offsets(), &bi = m1.indices();
+    const std::vector<T> &bx = m1.values();
+
+    // Each nonzero dense cell scales one sparse row into the result's row
+    DynMatrix<T> res{m0.rows(), m1.cols()};
+    for (size_t i = 0; i < m0.rows(); ++i)
+    {
+        const T *row = m0[i];
+        T *out = res[i];
+        for (size_t k = 0; k < m0.cols(); ++k)
+        {
+            if (row[k] == T{0})
+                continue;
+
+            for (size_t q = bp[k]; q < bp[k + 1]; ++q)
+                multiplyAdd(out[bi[q]], row[k], bx[q]);
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,478 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <include/dyn_matrix.hpp>
+#include <include/fraction.hpp>
+#include <include/sparse.hpp>
+
+// Sparse LU factorization, P * A * Q = L * U, by left-looking elimination
+// (Gilbert-Peierls): column k of L and U comes from one sparse triangular solve
+// with the columns already factorized, whose nonzero pattern is found first by
+// a depth-first search in L's graph. Work is proportional to the arithmetic
+// actually done, so it follows the nonzeros of the factors and not the order.
+//
+// How many nonzeros the factors get depends on the order in which columns are
+// eliminated. Q is a minimum degree ordering of A + A^T: at each step it takes
+// the column whose row and column have the fewest nonzeros left, which keeps
+// the fill-in, cells that are zero in A but not in L or U, small
+
+/// @brief Partial pivoting threshold of SparseLU for floating types: the diagonal cell is kept
+/// as pivot, preserving the ordering, while it is at least this fraction of its column's largest magnitude
+constexpr double sparsePivotThreshold = 0.1;
+
+/// @brief Whether a permutation is odd, by counting its cycles
+inline bool isOddPermutation(const std::vector<size_t> &p)
+{
+    std::vector<bool> seen(p.size(), false);
+    size_t transpositions = 0;
+    for (size_t i = 0; i < p.size(); ++i)
+    {
+        for (size_t j = i; !seen[j]; j = p[j])
+        {
+            seen[j] = true;
+            if (j != i)
+                ++transpositions;
+        }
+    }
+
+    return transpositions % 2 == 1;
+}
+
+/// @brief Minimum degree ordering of a square matrix's pattern, symmetrized as A + A^T.
+/// Eliminates one vertex at a time from the graph of nonzeros, choosing the one with fewest
+/// neighbours and joining all its neighbours into a clique (the fill its elimination causes).
+/// Approximate minimum degree orderings estimate these degrees to avoid storing the fill;
+/// this keeps the graph explicit and so follows the exact degrees
+/// @param m Matrix
+/// @return Elimination order: step k eliminates column order[k]
+template <typename T>
+std::vector<size_t> minimumDegreeOrdering(const SparseMatrix<T> &m)
+{
+    assert((m.rows() == m.cols()) && "Matrix must be square");
+
+    const size_t n = m.rows();
+    const SparseMatrix<T> t = m.transpose();
+
+    // Sorted neighbours of each vertex, without the vertex itself
+    std::vector<std::vector<size_t>> adj(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::vector<size_t> &a = adj[i];
+        std::set_union(m.indices().begin() + m.offsets()[i], m.indices().begin() + m.offsets()[i + 1],
+                       t.indices().begin() + t.offsets()[i], t.indices().begin() + t.offsets()[i + 1],
+                       std::back_inserter(a));
+        a.erase(std::remove(a.begin(), a.end(), i), a.end());
+    }
+
+    // Vertices by degree, ties broken by index so the ordering is deterministic
+    std::set<std::pair<size_t, size_t>> queue;
+    for (size_t i = 0; i < n; ++i)
+        queue.insert({adj[i].size(), i});
+
+    std::vector<size_t> order;
+    order.reserve(n);
+    std::vector<size_t> merged;
+    while (!queue.empty())
+    {
+        const size_t v = queue.begin()->second;
+        queue.erase(queue.begin());
+        order.push_back(v);
+
+        // Neighbours lose v and gain each other
+        const std::vector<size_t> clique = std::move(adj[v]);
+        adj[v].clear();
+        for (const size_t &u : clique)
+        {
+            std::vector<size_t> &a = adj[u];
+            queue.erase({a.size(), u});
+
+            merged.clear();
+            std::set_union(a.begin(), a.end(), clique.begin(), clique.end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(), [&](const size_t &w)
+                                        { return w == u || w == v; }),
+                         merged.end());
+            a.swap(merged);
+
+            queue.insert({a.size(), u});
+        }
+    }
+
+    return order;
+}
+
+/// @brief Sparse LU factorization with a fill-reducing column ordering and partial pivoting,
+/// P * A * Q = L * U. Computed once, it answers determinant and any number of solves
+/// @tparam T Matrix data type
+template <typename T>
+class SparseLU
+{
+public:
+    /// @brief Factorizes a matrix, eliminating columns in minimum degree order
+    /// @param m Square matrix
+    SparseLU(const SparseMatrix<T> &m);
+
+    /// @brief Factorizes a matrix, eliminating columns in a given order. Floating types take the
+    /// diagonal cell as pivot while it is within sparsePivotThreshold of the largest magnitude in
+    /// its column, and that largest one otherwise; exact types take the diagonal cell whenever it is nonzero
+    /// @param m Square matrix
+    /// @param order Column elimination order Q: step k eliminates column order[k]
+    SparseLU(const SparseMatrix<T> &m, const std::vector<size_t> &order);
+
+    /// @brief Whether the factorized matrix is singular
+    /// @return Whether some column had no pivot
+    bool isSingular() const;
+
+    /// @brief Determinant of the factorized matrix
+    /// @return Product of U's diagonal, with both permutations' signs
+    T determinant() const;
+
+    /// @brief Solves A * x = b
+    /// @param b Right-hand side
+    /// @return Solution x, or a null vector if A is singular
+    std::vector<T> solve(const std::vector<T> &b) const;
+
+    /// @brief Solves A * X = B, for every column of B
+    /// @param B Right-hand sides
+    /// @return Solution X, or a null matrix if A is singular
+    DynMatrix<T> solve(const DynMatrix<T> &B) const;
+
+    /// @brief Unit lower triangular factor L, empty if A is singular
+    SparseMatrix<T> lower() const;
+
+    /// @brief Upper triangular factor U, empty if A is singular
+    SparseMatrix<T> upper() const;
+
+    /// @brief Row permutation P: row k of P * A is row rowPermutation()[k] of A
+    std::vector<size_t> rowPermutation() const;
+
+    /// @brief Column permutation Q: column k of A * Q is column columnPermutation()[k] of A
+    const std::vector<size_t> &columnPermutation() const;
+
+    /// @brief Nonzeros stored in L and U together, L's unit diagonal included
+    size_t nonZeros() const;
+
+private:
+    /// @brief Replaces x by the solution of A * x = x
+    void substitute(std::vector<T> &x) const;
+
+    size_t n = 0;
+
+    // L and U in compressed sparse columns; each column of L starts with its unit
+    // diagonal, each column of U ends with its pivot
+    std::vector<size_t> lp, li, up, ui;
+    std::vector<T> lx, ux;
+
+    // pinv[i] is the step at which row i of A was pivot
+    std::vector<size_t> pinv;
+    std::vector<size_t> q;
+    bool singular = false;
+};
+
+template <typename T>
+SparseLU<T>::SparseLU(const SparseMatrix<T> &m) : SparseLU{m, minimumDegreeOrdering(m)}
+{
+}
+
+template <typename T>
+SparseLU<T>::SparseLU(const SparseMatrix<T> &m, const std::vector<size_t> &order) : n{m.rows()}, lp(m.rows() + 1, 0), up(m.rows() + 1, 0), pinv(m.rows(), -1), q{order}
+{
+    assert((m.rows() == m.cols()) && "Matrix must be square");
+    assert((order.size() == n) && "Order must have one entry per column");
+
+    // Columns of A are rows of its transpose
+    const SparseMatrix<T> a = m.transpose();
+    const std::vector<size_t> &ap = a.offsets(), &ai = a.indices();
+    const std::vector<T> &ax = a.values();
+
+    std::vector<T> x(n, T{0});
+    std::vector<size_t> reach(n), stack(n), next(n);
+    std::vector<bool> marked(n, false);
+    for (size_t k = 0; k < n; ++k)
+    {
+        lp[k] = li.size();
+        up[k] = ui.size();
+        const size_t col = q[k];
+
+        // Rows of x = L \ A(:, col) that can be nonzero: everything reachable from A(:, col)'s rows
+        // in L's graph, left in reach[top, n) in topological order
+        size_t top = n;
+        for (size_t p = ap[col]; p < ap[col + 1]; ++p)
+        {
+            if (marked[ai[p]])
+                continue;
+
+            // Iterative depth-first search
+            size_t head = 0;
+            stack[0] = ai[p];
+            marked[ai[p]] = true;
+            next[0] = pinv[ai[p]] == -1UL ? 0 : lp[pinv[ai[p]]] + 1;
+            while (true)
+            {
+                const size_t j = stack[head];
+                const size_t J = pinv[j];
+                const size_t end = J == -1UL ? 0 : lp[J + 1];
+                size_t &r = next[head];
+                while (r < end && marked[li[r]])
+                    ++r;
+
+                if (r < end)
+                {
+                    // Descend to the first unvisited child
+                    const size_t i = li[r++];
+                    marked[i] = true;
+                    stack[++head] = i;
+                    next[head] = pinv[i] == -1UL ? 0 : lp[pinv[i]] + 1;
+                    continue;
+                }
+
+                // All children done
+                reach[--top] = j;
+                if (head == 0)
+                    break;
+                --head;
+            }
+        }
+
+        // Sparse forward substitution over the reach
+        for (size_t p = ap[col]; p < ap[col + 1]; ++p)
+            x[ai[p]] = ax[p];
+        for (size_t p = top; p < n; ++p)
+        {
+            const size_t j = reach[p];
+            const size_t J = pinv[j];
+            if (J == -1UL || x[j] == T{0})
+                continue;
+
+            for (size_t r = lp[J] + 1; r < lp[J + 1]; ++r)
+                multiplyAdd(x[li[r]], -lx[r], x[j]);
+        }
+
+        // Choose the pivot among rows not yet pivotal; the others go to U
+        size_t pivotRow = -1;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            T best = T{0};
+            for (size_t p = top; p < n; ++p)
+            {
+                const size_t i = reach[p];
+                if (pinv[i] == -1UL && std::abs(x[i]) > best)
+                {
+                    best = std::abs(x[i]);
+                    pivotRow = i;
+                }
+            }
+            if (pinv[col] == -1UL && pivotRow != -1UL && std::abs(x[col]) >= sparsePivotThreshold * best)
+                pivotRow = col;
+        }
+        else
+        {
+            if (pinv[col] == -1UL && x[col] != T{0})
+                pivotRow = col;
+            for (size_t p = top; p < n && pivotRow == -1UL; ++p)
+            {
+                const size_t i = reach[p];
+                if (pinv[i] == -1UL && x[i] != T{0})
+                    pivotRow = i;
+            }
+        }
+
+        if (pivotRow == -1UL)
+        {
+            // Null column left, U has a zero on its diagonal
+            singular = true;
+            for (size_t p = top; p < n; ++p)
+            {
+                x[reach[p]] = T{0};
+                marked[reach[p]] = false;
+            }
+            break;
+        }
+
+        for (size_t p = top; p < n; ++p)
+        {
+            const size_t i = reach[p];
+            if (pinv[i] != -1UL && x[i] != T{0})
+            {
+                ui.push_back(pinv[i]);
+                ux.push_back(x[i]);
+            }
+        }
+        const T pivot = x[pivotRow];
+        ui.push_back(k);
+        ux.push_back(pivot);
+        pinv[pivotRow] = k;
+
+        // L's column: unit diagonal, then the remaining rows divided by the pivot
+        li.push_back(pivotRow);
+        lx.push_back(T{1});
+        const T inv = T{1} / pivot;
+        for (size_t p = top; p < n; ++p)
+        {
+            const size_t i = reach[p];
+            if (pinv[i] == -1UL && x[i] != T{0})
+            {
+                li.push_back(i);
+                lx.push_back(x[i] * inv);
+            }
+            x[i] = T{0};
+            marked[i] = false;
+        }
+    }
+
+    if (singular)
+    {
+        // Factors stay empty
+        std::fill(lp.begin(), lp.end(), 0);
+        std::fill(up.begin(), up.end(), 0);
+        li.clear();
+        lx.clear();
+        ui.clear();
+        ux.clear();
+        return;
+    }
+
+    lp[n] = li.size();
+    up[n] = ui.size();
+
+    // L's rows were recorded as rows of A, number them by step
+    for (size_t &i : li)
+        i = pinv[i];
+}
+
+template <typename T>
+bool SparseLU<T>::isSingular() const
+{
+    return singular;
+}
+
+template <typename T>
+T SparseLU<T>::determinant() const
+{
+    if (singular)
+        return T{0};
+
+    T det = isOddPermutation(pinv) != isOddPermutation(q) ? T{-1} : T{1};
+    for (size_t k = 0; k < n; ++k)
+        det *= ux[up[k + 1] - 1];
+
+    return det;
+}
+
+template <typename T>
+void SparseLU<T>::substitute(std::vector<T> &x) const
+{
+    // Permute rows, then forward substitution with L
+    std::vector<T> y(n);
+    for (size_t i = 0; i < n; ++i)
+        y[pinv[i]] = x[i];
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        if (y[j] == T{0})
+            continue;
+
+        for (size_t p = lp[j] + 1; p < lp[j + 1]; ++p)
+            multiplyAdd(y[li[p]], -lx[p], y[j]);
+    }
+
+    // Backward substitution with U, then undo the column order
+    for (size_t j = n; j-- > 0;)
+    {
+        y[j] /= ux[up[j + 1] - 1];
+        if (y[j] == T{0})
+            continue;
+
+        for (size_t p = up[j]; p < up[j + 1] - 1; ++p)
+            multiplyAdd(y[ui[p]], -ux[p], y[j]);
+    }
+
+    for (size_t k = 0; k < n; ++k)
+        x[q[k]] = y[k];
+}
+
+template <typename T>
+std::vector<T> SparseLU<T>::solve(const std::vector<T> &b) const
+{
+    assert((b.size() == n) && "Right-hand side's size must match matrix's order");
+
+    if (singular)
+    {
+        printf("No solution: matrix is singular\n\n");
+        return std::vector<T>(n, T{0});
+    }
+
+    std::vector<T> x{b};
+    substitute(x);
+    return x;
+}
+
+template <typename T>
+DynMatrix<T> SparseLU<T>::solve(const DynMatrix<T> &B) const
+{
+    assert((B.rows() == n) && "Right-hand sides' rows must match matrix's order");
+
+    if (singular)
+    {
+        printf("No solution: matrix is singular\n\n");
+        return DynMatrix<T>{n, B.cols()};
+    }
+
+    DynMatrix<T> X{n, B.cols()};
+    std::vector<T> x(n);
+    for (size_t c = 0; c < B.cols(); ++c)
+    {
+        for (size_t i = 0; i < n; ++i)
+            x[i] = B[i][c];
+
+        substitute(x);
+
+        for (size_t i = 0; i < n; ++i)
+            X[i][c] = x[i];
+    }
+
+    return X;
+}
+
+template <typename T>
+SparseMatrix<T> SparseLU<T>::lower() const
+{
+    // Compressed columns of L are compressed rows of L^T
+    return SparseMatrix<T>{n, n, lp, li, lx}.transpose();
+}
+
+template <typename T>
+SparseMatrix<T> SparseLU<T>::upper() const
+{
+    return SparseMatrix<T>{n, n, up, ui, ux}.transpose();
+}
+
+template <typename T>
+std::vector<size_t> SparseLU<T>::rowPermutation() const
+{
+    std::vector<size_t> p(n);
+    for (size_t i = 0; i < n; ++i)
+        p[pinv[i]] = i;
+
+    return p;
+}
+
+template <typename T>
+const std::vector<size_t> &SparseLU<T>::columnPermutation() const
+{
+    return q;
+}
+
+template <typename T>
+size_t SparseLU<T>::nonZeros() const
+{
+    return lx.size() + ux.size();
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+
+#include <include/dyn_matrix.hpp>
+#include <include/fraction.hpp>
+#include <include/matrix.hpp>
+
+// Strassen-Winograd product: each level splits both operands in 2x2 blocks and
+// forms the product from 7 block products and 15 block additions, instead of
+// 8 products and 4 additions. Below the crossover order it falls back on the
+// ordinary operator*, so large float and double blocks still reach the packed
+// kernel. Odd orders are padded with a zero row or column at each level.
+//
+// Trading a multiplication for additions pays off only when multiplying costs
+// far more than adding, so the crossover is tuned per cell type: exact types,
+// whose every product reduces a fraction, cross over much earlier than
+// machine numbers
+
+class BigFraction;
+
+/// @brief Order below which the Strassen-Winograd product uses the ordinary product, per cell type
+template <typename T>
+constexpr size_t strassenCrossover = std::is_arithmetic_v<T> ? 512 : 64;
+
+template <>
+inline constexpr size_t strassenCrossover<Fraction> = 64;
+
+template <>
+inline constexpr size_t strassenCrossover<BigFraction> = 16;
+
+/// @brief Number of scalar multiplications the Strassen-Winograd product performs
+/// @param m Left matrix's rows
+/// @param k Left matrix's columns and right matrix's rows
+/// @param n Right matrix's columns
+/// @param crossover Order below which the ordinary product is used
+/// @return Multiplications, m * k * n for the ordinary product
+inline uint64_t strassenMultiplications(const size_t &m, const size_t &k, const size_t &n, const size_t &crossover)
+{
+    if (m <= crossover || k <= crossover || n <= crossover)
+        return (uint64_t)m * k * n;
+
+    return 7 * strassenMultiplications((m + 1) / 2, (k + 1) / 2, (n + 1) / 2, crossover);
+}
+
+/// @brief Copies a block of a matrix, padding with zeros past its last row or column
+/// @param m Matrix
+/// @param r First row
+/// @param c First column
+/// @param rows Rows of the block
+/// @param cols Columns of the block
+/// @return Block
+template <typename T>
+DynMatrix<T> strassenBlock(const DynMatrix<T> &m, const size_t &r, const size_t &c, const size_t &rows, const size_t &cols)
+{
+    DynMatrix<T> res{rows, cols};
+    const size_t endRow = r + rows < m.rows() ? r + rows : m.rows();
+    const size_t endCol = c + cols < m.cols() ? c + cols : m.cols();
+    for (size_t i = r; i < endRow; ++i)
+    {
+        std::copy(m[i] + c, m[i] + endCol, res[i - r]);
+    }
+
+    return res;
+}
+
+/// @brief Copies a block into a matrix, dropping the padding past its last row or column
+/// @param m Matrix
+/// @param block Block
+/// @param r First row
+/// @param c First column
+template <typename T>
+void strassenStore(DynMatrix<T> &m, const DynMatrix<T> &block, const size_t &r, const size_t &c)
+{
+    const size_t endRow = r + block.rows() < m.rows() ? r + block.rows() : m.rows();
+    const size_t endCol = c + block.cols() < m.cols() ? c + block.cols() : m.cols();
+    for (size_t i = r; i < endRow; ++i)
+    {
+        std::copy(block[i - r], block[i - r] + (endCol - c), m[i] + c);
+    }
+}
+
+/// @brief Product of 2 matrices by Strassen-Winograd recursion
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @param crossover Order below which the ordinary product is used, strassenCrossover<T> by default
+/// @return Result of product
+template <typename T>
+DynMatrix<T> strassenProduct(const DynMatrix<T> &m0, const DynMatrix<T> &m1, const size_t &crossover = strassenCrossover<T>)
+{
+    assert((m0.cols() == m1.rows()) && "Left matrix's columns must match right matrix's rows");
+
+    const size_t m = m0.rows();
+    const size_t k = m0.cols();
+    const size_t n = m1.cols();
+    if (m <= crossover || k <= crossover || n <= crossover)
+        return m0 * m1;
+
+    const size_t hm = (m + 1) / 2;
+    const size_t hk = (k + 1) / 2;
+    const size_t hn = (n + 1) / 2;
+    const DynMatrix<T> a11 = strassenBlock(m0, 0, 0, hm, hk);
+    const DynMatrix<T> a12 = strassenBlock(m0, 0, hk, hm, hk);
+    const DynMatrix<T> a21 = strassenBlock(m0, hm, 0, hm, hk);
+    const DynMatrix<T> a22 = strassenBlock(m0, hm, hk, hm, hk);
+    const DynMatrix<T> b11 = strassenBlock(m1, 0, 0, hk, hn);
+    const DynMatrix<T> b12 = strassenBlock(m1, 0, hn, hk, hn);
+    const DynMatrix<T> b21 = strassenBlock(m1, hk, 0, hk, hn);
+    const DynMatrix<T> b22 = strassenBlock(m1, hk, hn, hk, hn);
+
+    // 8 block additions on the operands
+    const DynMatrix<T> s1 = a21 + a22;
+    const DynMatrix<T> s2 = s1 - a11;
+    const DynMatrix<T> s3 = a11 - a21;
+    const DynMatrix<T> s4 = a12 - s2;
+    const DynMatrix<T> t1 = b12 - b11;
+    const DynMatrix<T> t2 = b22 - t1;
+    const DynMatrix<T> t3 = b22 - b12;
+    const DynMatrix<T> t4 = t2 - b21;
+
+    // 7 block products
+    DynMatrix<T> p1 = strassenProduct(a11, b11, crossover);
+    DynMatrix<T> p2 = strassenProduct(a12, b21, crossover);
+    DynMatrix<T> p3 = strassenProduct(s4, b22, crossover);
+    DynMatrix<T> p4 = strassenProduct(a22, t4, crossover);
+    DynMatrix<T> p5 = strassenProduct(s1, t1, crossover);
+    DynMatrix<T> p6 = strassenProduct(s2, t2, crossover);
+    DynMatrix<T> p7 = strassenProduct(s3, t3, crossover);
+
+    // 7 block additions on the products, accumulated in place
+    p6 += p1;                // u2 = p1 + p6
+    p7 += p6;                // u3 = u2 + p7
+    p6 += p5;                // u4 = u2 + p5
+    p6 += p3;                // c12 = u4 + p3
+    p4 = p7 - std::move(p4); // c21 = u3 - p4
+    p7 += p5;                // c22 = u3 + p5
+    p1 += p2;                // c11 = p1 + p2
+
+    DynMatrix<T> res{m, n};
+    strassenStore(res, p1, 0, 0);
+    strassenStore(res, p6, 0, hn);
+    strassenStore(res, p4, hm, 0);
+    strassenStore(res, p7, hm, hn);
+
+    return res;
+}
+
+/// @brief Product of 2 matrices by Strassen-Winograd recursion
+/// @param m0 Left matrix
+/// @param m1 Right matrix
+/// @param crossover Order below which the ordinary product is used, strassenCrossover<T> by default
+/// @return Result of product
+template <size_t R, size_t M, size_t C, typename T>
+Matrix<R, C, T> strassenProduct(const Matrix<R, M, T> &m0, const Matrix<M, C, T> &m1, const size_t &crossover = strassenCrossover<T>)
+{
+    return strassenProduct(DynMatrix<T>{m0}, DynMatrix<T>{m1}, crossover).template toMatrix<R, C>();
+}
@@ -0,0 +1,1086 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include <include/fraction.hpp>
+#include <include/lu.hpp>
+#include <include/matrix.hpp>
+
+// Structured square matrices, storing only the cells their structure allows to
+// be nonzero:
+//
+//   DiagonalMatrix      N cells
+//   TriangularMatrix    N * (N + 1) / 2 cells, upper or lower, packed by rows
+//   SymmetricMatrix     N * (N + 1) / 2 cells, the lower triangle packed by rows
+//   BandMatrix          N * (2K + 1) cells, those within K of the diagonal
+//
+// Determinants, inverses, solves and products run over the stored cells only:
+// a triangular inverse is a substitution instead of a full elimination, a band
+// factorization does O(N * K^2) work, and products with a dense Matrix skip the
+// cells known to be zero. Every type converts to and from a dense Matrix;
+// conversion from one keeps the cells of the structure and drops the rest
+
+/// @brief Which triangle of a TriangularMatrix is stored
+enum class Triangle
+{
+    upper,
+    lower,
+};
+
+/// @brief Diagonal matrix, storing its N diagonal cells
+/// @tparam N Matrix order
+/// @tparam T Matrix data type
+template <size_t N, typename T>
+class DiagonalMatrix
+{
+public:
+    /// @brief Constructor with initial diagonal value
+    /// @param v Optional initial value
+    DiagonalMatrix(const T &v = T{0});
+
+    /// @brief Takes the diagonal of a dense matrix
+    /// @param m Matrix
+    explicit DiagonalMatrix(const Matrix<N, N, T> &m);
+
+    /// @brief Value of a cell
+    /// @param i Row
+    /// @param j Column
+    /// @return Cell's value, zero off the diagonal
+    T operator()(const size_t &i, const size_t &j) const;
+
+    /// @brief Dense copy
+    Matrix<N, N, T> toMatrix() const;
+
+    /// @brief Product of the diagonal
+    T determinant() const;
+
+    /// @brief Inverse, the reciprocal of each diagonal cell
+    /// @return Inverse, or a null matrix if some diagonal cell is null
+    DiagonalMatrix<N, T> inverse() const;
+
+    /// @brief Solves D * X = B, dividing each row of B by its diagonal cell
+    /// @param B Right-hand sides
+    /// @return Solution X, or a null matrix if D is singular
+    template <size_t C>
+    Matrix<N, C, T> solve(const Matrix<N, C, T> &B) const;
+
+    /// @brief Diagonal cells
+    T data[N];
+};
+
+/// @brief Triangular matrix, storing the N * (N + 1) / 2 cells of one triangle packed by rows
+/// @tparam N Matrix order
+/// @tparam T Matrix data type
+/// @tparam S Stored triangle
+template <size_t N, typename T, Triangle S>
+class TriangularMatrix
+{
+public:
+    /// @brief Number of stored cells
+    static constexpr size_t cells = N * (N + 1) / 2;
+
+    /// @brief Constructor with initial value for the stored triangle
+    /// @param v Optional initial value
+    TriangularMatrix(const T &v = T{0});
+
+    /// @brief Takes one triangle of a dense matrix
+    /// @param m Matrix
+    explicit TriangularMatrix(const Matrix<N, N, T> &m);
+
+    /// @brief Whether a cell is in the stored triangle
+    static constexpr bool stored(const size_t &i, const size_t &j);
+
+    /// @brief Position of a stored cell in data
+    static constexpr size_t index(const size_t &i, const size_t &j);
+
+    /// @brief Value of a cell
+    /// @param i Row
+    /// @param j Column
+    /// @return Cell's value, zero outside the stored triangle
+    T operator()(const size_t &i, const size_t &j) const;
+
+    /// @brief Reference to a cell of the stored triangle
+    /// @param i Row
+    /// @param j Column
+    T &operator()(const size_t &i, const size_t &j);
+
+    /// @brief Dense copy
+    Matrix<N, N, T> toMatrix() const;
+
+    /// @brief Product of the diagonal
+    T determinant() const;
+
+    /// @brief Inverse, by substitution along packed rows; the inverse of a triangular matrix is triangular
+    /// @return Inverse, or a null matrix if some diagonal cell is null
+    TriangularMatrix<N, T, S> inverse() const;
+
+    /// @brief Solves A * X = B by forward (lower) or backward (upper) substitution
+    /// @param B Right-hand sides
+    /// @return Solution X, or a null matrix if A is singular
+    template <size_t C>
+    Matrix<N, C, T> solve(const Matrix<N, C, T> &B) const;
+
+    /// @brief Stored triangle, packed by rows
+    T data[cells];
+};
+
+template <size_t N, typename T>
+using UpperTriangularMatrix = TriangularMatrix<N, T, Triangle::upper>;
+
+template <size_t N, typename T>
+using LowerTriangularMatrix = TriangularMatrix<N, T, Triangle::lower>;
+
+/// @brief Symmetric matrix, storing its lower triangle packed by rows. Determinant, inverse
+/// and solves factorize it as L * D * L^T, which keeps the symmetry and halves the work of LU;
+/// the factorization does not pivot, so should a pivot be null they fall back on LU
+/// @tparam N Matrix order
+/// @tparam T Matrix data type
+template <size_t N, typename T>
+class SymmetricMatrix
+{
+public:
+    /// @brief Number of stored cells
+    static constexpr size_t cells = N * (N + 1) / 2;
+
+    /// @brief Constructor with initial cell value
+    /// @param v Optional initial value
+    SymmetricMatrix(const T &v = T{0});
+
+    /// @brief Takes the lower triangle of a dense matrix
+    /// @param m Matrix
+    explicit SymmetricMatrix(const Matrix<N, N, T> &m);
+
+    /// @brief Position of a cell in data; (i, j) and (j, i) share it
+    static constexpr size_t index(const size_t &i, const size_t &j);
+
+    /// @brief Value of a cell
+    T operator()(const size_t &i, const size_t &j) const;
+
+    /// @brief Reference to a cell, shared with its mirror
+    T &operator()(const size_t &i, const size_t &j);
+
+    /// @brief Dense copy
+    Matrix<N, N, T> toMatrix() const;
+
+    /// @brief Product of D's diagonal
+    T determinant() const;
+
+    /// @brief Inverse, symmetric as well
+    /// @return Inverse, or a null matrix if the matrix is singular
+    SymmetricMatrix<N, T> inverse() const;
+
+    /// @brief Solves A * X = B
+    /// @param B Right-hand sides
+    /// @return Solution X, or a null matrix if A is singular
+    template <size_t C>
+    Matrix<N, C, T> solve(const Matrix<N, C, T> &B) const;
+
+    /// @brief Lower triangle, packed by rows
+    T data[cells];
+
+private:
+    /// @brief Factorizes into L * D * L^T, L's unit diagonal implicit and D on its diagonal
+    /// @param ldl Packed factors
+    /// @return Whether every pivot was nonzero
+    bool factorize(T (&ldl)[cells]) const;
+
+    /// @brief Replaces B by X in L * D * L^T * X = B
+    template <size_t C>
+    static void substitute(const T (&ldl)[cells], Matrix<N, C, T> &B);
+};
+
+/// @brief Band matrix, storing the cells within K of the diagonal, 2K + 1 per row. Its
+/// determinant and solves use a band LU with partial pivoting, whose factors keep within
+/// 2K of the diagonal, so cost grows as N * K^2 instead of N^3
+/// @tparam N Matrix order
+/// @tparam K Bandwidth: cells with |i - j| > K are zero
+/// @tparam T Matrix data type
+template <size_t N, size_t K, typename T>
+class BandMatrix
+{
+public:
+    /// @brief Stored cells per row
+    static constexpr size_t width = 2 * K + 1;
+
+    /// @brief Constructor with initial value for the band
+    /// @param v Optional initial value
+    BandMatrix(const T &v = T{0});
+
+    /// @brief Takes the band of a dense matrix
+    /// @param m Matrix
+    explicit BandMatrix(const Matrix<N, N, T> &m);
+
+    /// @brief Whether a cell is in the band
+    static constexpr bool stored(const size_t &i, const size_t &j);
+
+    /// @brief Value of a cell
+    /// @return Cell's value, zero outside the band
+    T operator()(const size_t &i, const size_t &j) const;
+
+    /// @brief Reference to a cell of the band
+    T &operator()(const size_t &i, const size_t &j);
+
+    /// @brief Dense copy
+    Matrix<N, N, T> toMatrix() const;
+
+    /// @brief Determinant, by band LU
+    T determinant() const;
+
+    /// @brief Inverse, which is dense in general
+    /// @return Inverse, or a null matrix if the matrix is singular
+    Matrix<N, N, T> inverse() const;
+
+    /// @brief Solves A * X = B by band LU
+    /// @param B Right-hand sides
+    /// @return Solution X, or a null matrix if A is singular
+    template <size_t C>
+    Matrix<N, C, T> solve(const Matrix<N, C, T> &B) const;
+
+    /// @brief Band, row by row: cell (i, j) is data[i][j - i + K]
+    T data[N][width];
+
+private:
+    /// @brief Band LU workspace: row i holds columns i - K to i + 2K, the band
+    /// widened by the K diagonals row swaps can add above it
+    struct Factors
+    {
+        T cells[N][3 * K + 1];
+        size_t pivot[N];
+        bool odd = false;
+
+        T &operator()(const size_t &i, const size_t &j) { return cells[i][j + K - i]; }
+        const T &operator()(const size_t &i, const size_t &j) const { return cells[i][j + K - i]; }
+    };
+
+    /// @brief Factorizes in place into band L and U, swapping rows c and pivot[c] at step c
+    /// @return Whether the matrix is nonsingular
+    bool factorize(Factors &f) const;
+
+    /// @brief Replaces B by X in A * X = B, given A's factors
+    template <size_t C>
+    static void substitute(const Factors &f, Matrix<N, C, T> &B);
+};
+
+// Products exploiting structure
+
+/// @brief Product of a diagonal and a dense matrix, scaling each row
+template <size_t N, size_t C, typename T>
+Matrix<N, C, T> operator*(const DiagonalMatrix<N, T> &d, const Matrix<N, C, T> &m);
+
+/// @brief Product of a dense and a diagonal matrix, scaling each column
+template <size_t R, size_t N, typename T>
+Matrix<R, N, T> operator*(const Matrix<R, N, T> &m, const DiagonalMatrix<N, T> &d);
+
+/// @brief Product of 2 diagonal matrices
+template <size_t N, typename T>
+DiagonalMatrix<N, T> operator*(const DiagonalMatrix<N, T> &d0, const DiagonalMatrix<N, T> &d1);
+
+/// @brief Product of a triangular and a dense matrix, over the stored triangle only
+template <size_t N, size_t C, typename T, Triangle S>
+Matrix<N, C, T> operator*(const TriangularMatrix<N, T, S> &t, const Matrix<N, C, T> &m);
+
+/// @brief Product of 2 triangular matrices of the same kind, which is triangular too
+template <size_t N, typename T, Triangle S>
+TriangularMatrix<N, T, S> operator*(const TriangularMatrix<N, T, S> &t0, const TriangularMatrix<N, T, S> &t1);
+
+/// @brief Product of a symmetric and a dense matrix, reading each stored cell once
+template <size_t N, size_t C, typename T>
+Matrix<N, C, T> operator*(const SymmetricMatrix<N, T> &s, const Matrix<N, C, T> &m);
+
+/// @brief Product of a band and a dense matrix, over the band only
+template <size_t N, size_t K, size_t C, typename T>
+Matrix<N, C, T> operator*(const BandMatrix<N, K, T> &b, const Matrix<N, C, T> &m);
+
+// DiagonalMatrix
+
+template <size_t N, typename T>
+DiagonalMatrix<N, T>::DiagonalMatrix(const T &v)
+{
+    for (size_t i = 0; i < N; ++i)
+        data[i] = v;
+}
+
+template <size_t N, typename T>
+DiagonalMatrix<N, T>::DiagonalMatrix(const Matrix<N, N, T> &m)
+{
+    for (size_t i = 0; i < N; ++i)
+        data[i] = m.data[i][i];
+}
+
+template <size_t N, typename T>
+T DiagonalMatrix<N, T>::operator()(const size_t &i, const size_t &j) const
+{
+    assert((i < N && j < N) && "Cell out of range");
+    return i == j ? data[i] : T{0};
+}
+
+template <size_t N, typename T>
+Matrix<N, N, T> DiagonalMatrix<N, T>::toMatrix() const
+{
+    Matrix<N, N, T> res{};
+    for (size_t i = 0; i < N; ++i)
+        res.data[i][i] = data[i];
+
+    return res;
+}
+
+template <size_t N, typename T>
+T DiagonalMatrix<N, T>::determinant() const
+{
+    T det{1};
+    for (size_t i = 0; i < N; ++i)
+        det *= data[i];
+
+    return det;
+}
+
+template <size_t N, typename T>
+DiagonalMatrix<N, T> DiagonalMatrix<N, T>::inverse() const
+{
+    DiagonalMatrix<N, T> res;
+    for (size_t i = 0; i < N; ++i)
+    {
+        if (data[i] == T{0})
+        {
+            printf("No inverse: matrix is singular\n\n");
+            return DiagonalMatrix<N, T>();
+        }
+        res.data[i] = T{1} / data[i];
+    }
+
+    return res;
+}
+
+template <size_t N, typename T>
+template <size_t C>
+Matrix<N, C, T> DiagonalMatrix<N, T>::solve(const Matrix<N, C, T> &B) const
+{
+    Matrix<N, C, T> X{B};
+    for (size_t i = 0; i < N; ++i)
+    {
+        if (data[i] == T{0})
+        {
+            printf("No solution: matrix is singular\n\n");
+            return Matrix<N, C, T>();
+        }
+        X.multiplyRow(i, T{1} / data[i]);
+    }
+
+    return X;
+}
+
+// TriangularMatrix
+
+template <size_t N, typename T, Triangle S>
+TriangularMatrix<N, T, S>::TriangularMatrix(const T &v)
+{
+    for (size_t k = 0; k < cells; ++k)
+        data[k] = v;
+}
+
+template <size_t N, typename T, Triangle S>
+TriangularMatrix<N, T, S>::TriangularMatrix(const Matrix<N, N, T> &m)
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (stored(i, j))
+                data[index(i, j)] = m.data[i][j];
+        }
+    }
+}
+
+template <size_t N, typename T, Triangle S>
+constexpr bool TriangularMatrix<N, T, S>::stored(const size_t &i, const size_t &j)
+{
+    return S == Triangle::upper ? j >= i : j <= i;
+}
+
+template <size_t N, typename T, Triangle S>
+constexpr size_t TriangularMatrix<N, T, S>::index(const size_t &i, const size_t &j)
+{
+    // Upper rows shrink from N cells, lower rows grow from 1
+    if constexpr (S == Triangle::upper)
+        return i * N - i * (i - 1) / 2 + (j - i);
+    else
+        return i * (i + 1) / 2 + j;
+}
+
+template <size_t N, typename T, Triangle S>
+T TriangularMatrix<N, T, S>::operator()(const size_t &i, const size_t &j) const
+{
+    assert((i < N && j < N) && "Cell out of range");
+    return stored(i, j) ? data[index(i, j)] : T{0};
+}
+
+template <size_t N, typename T, Triangle S>
+T &TriangularMatrix<N, T, S>::operator()(const size_t &i, const size_t &j)
+{
+    assert((i < N && j < N && stored(i, j)) && "Cell outside the stored triangle");
+    return data[index(i, j)];
+}
+
+template <size_t N, typename T, Triangle S>
+Matrix<N, N, T> TriangularMatrix<N, T, S>::toMatrix() const
+{
+    Matrix<N, N, T> res{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (stored(i, j))
+                res.data[i][j] = data[index(i, j)];
+        }
+    }
+
+    return res;
+}
+
+template <size_t N, typename T, Triangle S>
+T TriangularMatrix<N, T, S>::determinant() const
+{
+    T det{1};
+    for (size_t i = 0; i < N; ++i)
+        det *= data[index(i, i)];
+
+    return det;
+}
+
+template <size_t N, typename T, Triangle S>
+TriangularMatrix<N, T, S> TriangularMatrix<N, T, S>::inverse() const
+{
+    T inv[N];
+    for (size_t i = 0; i < N; ++i)
+    {
+        if (data[index(i, i)] == T{0})
+        {
+            printf("No inverse: matrix is singular\n\n");
+            return TriangularMatrix<N, T, S>();
+        }
+        inv[i] = T{1} / data[index(i, i)];
+    }
+
+    // Row i of the inverse is (e_i - sum of A(i, k) times row k of the inverse) / A(i, i), over
+    // the k of row i's triangle. Rows of the inverse keep to the same triangle, so each update
+    // runs along one packed row, from the diagonal to the triangle's edge
+    TriangularMatrix<N, T, S> res;
+    for (size_t n = 0; n < N; ++n)
+    {
+        const size_t i = S == Triangle::lower ? n : N - 1 - n;
+        T *row = res.data + index(i, S == Triangle::lower ? 0 : i);
+        const size_t first = S == Triangle::lower ? 0 : i;
+        row[i - first] = T{1};
+
+        const size_t begin = S == Triangle::lower ? 0 : i + 1;
+        const size_t end = S == Triangle::lower ? i : N;
+        for (size_t k = begin; k < end; ++k)
+        {
+            const T a = data[index(i, k)];
+            if (a == T{0})
+                continue;
+
+            // Row k of the inverse covers columns [0, k] (lower) or [k, N) (upper)
+            const T *other = res.data + index(k, S == Triangle::lower ? 0 : k);
+            const size_t from = S == Triangle::lower ? 0 : k;
+            const size_t to = S == Triangle::lower ? k + 1 : N;
+            for (size_t j = from; j < to; ++j)
+                multiplyAdd(row[j - first], -a, other[j - from]);
+        }
+
+        const size_t last = S == Triangle::lower ? i + 1 : N;
+        for (size_t j = first; j < last; ++j)
+            row[j - first] *= inv[i];
+    }
+
+    return res;
+}
+
+template <size_t N, typename T, Triangle S>
+template <size_t C>
+Matrix<N, C, T> TriangularMatrix<N, T, S>::solve(const Matrix<N, C, T> &B) const
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        if (data[index(i, i)] == T{0})
+        {
+            printf("No solution: matrix is singular\n\n");
+            return Matrix<N, C, T>();
+        }
+    }
+
+    Matrix<N, C, T> X{B};
+    for (size_t n = 0; n < N; ++n)
+    {
+        // Rows in the order their dependencies are solved
+        const size_t i = S == Triangle::lower ? n : N - 1 - n;
+        const size_t begin = S == Triangle::lower ? 0 : i + 1;
+        const size_t end = S == Triangle::lower ? i : N;
+        for (size_t k = begin; k < end; ++k)
+        {
+            const T a = data[index(i, k)];
+            if (a == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(X.data[i][j], -a, X.data[k][j]);
+        }
+        X.multiplyRow(i, T{1} / data[index(i, i)]);
+    }
+
+    return X;
+}
+
+// SymmetricMatrix
+
+template <size_t N, typename T>
+SymmetricMatrix<N, T>::SymmetricMatrix(const T &v)
+{
+    for (size_t k = 0; k < cells; ++k)
+        data[k] = v;
+}
+
+template <size_t N, typename T>
+SymmetricMatrix<N, T>::SymmetricMatrix(const Matrix<N, N, T> &m)
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j <= i; ++j)
+            data[index(i, j)] = m.data[i][j];
+    }
+}
+
+template <size_t N, typename T>
+constexpr size_t SymmetricMatrix<N, T>::index(const size_t &i, const size_t &j)
+{
+    return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+}
+
+template <size_t N, typename T>
+T SymmetricMatrix<N, T>::operator()(const size_t &i, const size_t &j) const
+{
+    assert((i < N && j < N) && "Cell out of range");
+    return data[index(i, j)];
+}
+
+template <size_t N, typename T>
+T &SymmetricMatrix<N, T>::operator()(const size_t &i, const size_t &j)
+{
+    assert((i < N && j < N) && "Cell out of range");
+    return data[index(i, j)];
+}
+
+template <size_t N, typename T>
+Matrix<N, N, T> SymmetricMatrix<N, T>::toMatrix() const
+{
+    Matrix<N, N, T> res{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j <= i; ++j)
+        {
+            res.data[i][j] = data[index(i, j)];
+            res.data[j][i] = data[index(i, j)];
+        }
+    }
+
+    return res;
+}
+
+template <size_t N, typename T>
+bool SymmetricMatrix<N, T>::factorize(T (&ldl)[cells]) const
+{
+    for (size_t k = 0; k < cells; ++k)
+        ldl[k] = data[k];
+
+    // Right-looking, on the lower triangle only: after d_j = a_jj, each row i below takes
+    // l_ij = a_ij / d_j, and a_ik -= l_ij * a_kj for j < k <= i, along the packed row
+    T col[N];
+    for (size_t j = 0; j < N; ++j)
+    {
+        const T d = ldl[index(j, j)];
+        if (d == T{0})
+            return false;
+
+        const T inv = T{1} / d;
+        for (size_t k = j + 1; k < N; ++k)
+        {
+            col[k] = ldl[index(k, j)];
+            ldl[index(k, j)] = col[k] * inv;
+        }
+
+        for (size_t i = j + 1; i < N; ++i)
+        {
+            const T l = ldl[index(i, j)];
+            if (l == T{0})
+                continue;
+
+            T *row = ldl + index(i, 0);
+            for (size_t k = j + 1; k <= i; ++k)
+                multiplyAdd(row[k], -l, col[k]);
+        }
+    }
+
+    return true;
+}
+
+template <size_t N, typename T>
+template <size_t C>
+void SymmetricMatrix<N, T>::substitute(const T (&ldl)[cells], Matrix<N, C, T> &B)
+{
+    // L * Y = B
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t k = 0; k < i; ++k)
+        {
+            const T l = ldl[index(i, k)];
+            if (l == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(B.data[i][j], -l, B.data[k][j]);
+        }
+    }
+
+    // D * Z = Y
+    for (size_t i = 0; i < N; ++i)
+        B.multiplyRow(i, T{1} / ldl[index(i, i)]);
+
+    // L^T * X = Z
+    for (size_t i = N; i-- > 0;)
+    {
+        for (size_t k = i + 1; k < N; ++k)
+        {
+            const T l = ldl[index(k, i)];
+            if (l == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(B.data[i][j], -l, B.data[k][j]);
+        }
+    }
+}
+
+template <size_t N, typename T>
+T SymmetricMatrix<N, T>::determinant() const
+{
+    T ldl[cells];
+    if (!factorize(ldl))
+        return LU<N, T>{toMatrix()}.determinant();
+
+    T det{1};
+    for (size_t i = 0; i < N; ++i)
+        det *= ldl[index(i, i)];
+
+    return det;
+}
+
+template <size_t N, typename T>
+SymmetricMatrix<N, T> SymmetricMatrix<N, T>::inverse() const
+{
+    T ldl[cells];
+    if (!factorize(ldl))
+    {
+        const LU<N, T> lu{toMatrix()};
+        if (lu.isSingular())
+        {
+            printf("No inverse: matrix is singular\n\n");
+            return SymmetricMatrix<N, T>();
+        }
+        return SymmetricMatrix<N, T>{lu.inverse()};
+    }
+
+    // A^-1 = W^T * D^-1 * W with W = L^-1, unit lower triangular. Only the lower
+    // triangle of the result is formed: cell (i, j), i >= j, sums W(k, i) * W(k, j) / d_k over k >= i
+    LowerTriangularMatrix<N, T> l;
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < i; ++j)
+            l.data[index(i, j)] = ldl[index(i, j)];
+        l.data[index(i, i)] = T{1};
+    }
+    const LowerTriangularMatrix<N, T> w = l.inverse();
+
+    SymmetricMatrix<N, T> res;
+    T v[N];
+    for (size_t k = 0; k < N; ++k)
+    {
+        const T inv = T{1} / ldl[index(k, k)];
+        for (size_t j = 0; j <= k; ++j)
+            v[j] = w.data[index(k, j)] * inv;
+
+        for (size_t i = 0; i <= k; ++i)
+        {
+            const T a = w.data[index(k, i)];
+            if (a == T{0})
+                continue;
+
+            T *row = res.data + index(i, 0);
+            for (size_t j = 0; j <= i; ++j)
+                multiplyAdd(row[j], a, v[j]);
+        }
+    }
+
+    return res;
+}
+
+template <size_t N, typename T>
+template <size_t C>
+Matrix<N, C, T> SymmetricMatrix<N, T>::solve(const Matrix<N, C, T> &B) const
+{
+    T ldl[cells];
+    if (!factorize(ldl))
+        return LU<N, T>{toMatrix()}.solve(B);
+
+    Matrix<N, C, T> X{B};
+    substitute(ldl, X);
+    return X;
+}
+
+// BandMatrix
+
+template <size_t N, size_t K, typename T>
+BandMatrix<N, K, T>::BandMatrix(const T &v)
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t t = 0; t < width; ++t)
+            data[i][t] = stored(i, i + t - K) ? v : T{0};
+    }
+}
+
+template <size_t N, size_t K, typename T>
+BandMatrix<N, K, T>::BandMatrix(const Matrix<N, N, T> &m)
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t t = 0; t < width; ++t)
+        {
+            const size_t j = i + t - K;
+            data[i][t] = stored(i, j) ? m.data[i][j] : T{0};
+        }
+    }
+}
+
+template <size_t N, size_t K, typename T>
+constexpr bool BandMatrix<N, K, T>::stored(const size_t &i, const size_t &j)
+{
+    // Column indices left of 0 wrap around to huge values, and fail j < N
+    return j < N && i <= j + K && j <= i + K;
+}
+
+template <size_t N, size_t K, typename T>
+T BandMatrix<N, K, T>::operator()(const size_t &i, const size_t &j) const
+{
+    assert((i < N && j < N) && "Cell out of range");
+    return stored(i, j) ? data[i][j + K - i] : T{0};
+}
+
+template <size_t N, size_t K, typename T>
+T &BandMatrix<N, K, T>::operator()(const size_t &i, const size_t &j)
+{
+    assert((i < N && stored(i, j)) && "Cell outside the band");
+    return data[i][j + K - i];
+}
+
+template <size_t N, size_t K, typename T>
+Matrix<N, N, T> BandMatrix<N, K, T>::toMatrix() const
+{
+    Matrix<N, N, T> res{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t t = 0; t < width; ++t)
+        {
+            const size_t j = i + t - K;
+            if (stored(i, j))
+                res.data[i][j] = data[i][t];
+        }
+    }
+
+    return res;
+}
+
+template <size_t N, size_t K, typename T>
+bool BandMatrix<N, K, T>::factorize(Factors &f) const
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t t = 0; t < 3 * K + 1; ++t)
+            f.cells[i][t] = t < width ? data[i][t] : T{0};
+    }
+
+    for (size_t c = 0; c < N; ++c)
+    {
+        // Candidates are the K rows below the diagonal, the band's lower edge
+        const size_t last = c + K < N ? c + K : N - 1;
+        size_t row = -1;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            T best = T{0};
+            for (size_t i = c; i <= last; ++i)
+            {
+                if (std::abs(f(i, c)) > best)
+                {
+                    best = std::abs(f(i, c));
+                    row = i;
+                }
+            }
+        }
+        else
+        {
+            for (size_t i = c; i <= last && row == -1UL; ++i)
+            {
+                if (f(i, c) != T{0})
+                    row = i;
+            }
+        }
+
+        if (row == -1UL)
+            return false;
+
+        // Rows c to c + K reach column c + 2K at most
+        const size_t end = c + 2 * K < N ? c + 2 * K : N - 1;
+        f.pivot[c] = row;
+        if (row != c)
+        {
+            f.odd = !f.odd;
+            for (size_t j = c; j <= end; ++j)
+                std::swap(f(c, j), f(row, j));
+        }
+
+        const T inv = T{1} / f(c, c);
+        for (size_t i = c + 1; i <= last; ++i)
+        {
+            if (f(i, c) == T{0})
+                continue;
+
+            const T l = f(i, c) * inv;
+            f(i, c) = l;
+            for (size_t j = c + 1; j <= end; ++j)
+                multiplyAdd(f(i, j), -l, f(c, j));
+        }
+    }
+
+    return true;
+}
+
+template <size_t N, size_t K, typename T>
+template <size_t C>
+void BandMatrix<N, K, T>::substitute(const Factors &f, Matrix<N, C, T> &B)
+{
+    // Replay the row swaps and L's eliminations on B
+    for (size_t c = 0; c < N; ++c)
+    {
+        if (f.pivot[c] != c)
+            B.swapRows(c, f.pivot[c]);
+
+        const size_t last = c + K < N ? c + K : N - 1;
+        for (size_t i = c + 1; i <= last; ++i)
+        {
+            const T l = f(i, c);
+            if (l == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(B.data[i][j], -l, B.data[c][j]);
+        }
+    }
+
+    // Backward substitution with U, within 2K of the diagonal
+    for (size_t i = N; i-- > 0;)
+    {
+        const size_t end = i + 2 * K < N ? i + 2 * K : N - 1;
+        for (size_t k = i + 1; k <= end; ++k)
+        {
+            const T u = f(i, k);
+            if (u == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(B.data[i][j], -u, B.data[k][j]);
+        }
+        B.multiplyRow(i, T{1} / f(i, i));
+    }
+}
+
+template <size_t N, size_t K, typename T>
+T BandMatrix<N, K, T>::determinant() const
+{
+    Factors f;
+    if (!factorize(f))
+        return T{0};
+
+    T det = f.odd ? T{-1} : T{1};
+    for (size_t i = 0; i < N; ++i)
+        det *= f(i, i);
+
+    return det;
+}
+
+template <size_t N, size_t K, typename T>
+Matrix<N, N, T> BandMatrix<N, K, T>::inverse() const
+{
+    Factors f;
+    if (!factorize(f))
+    {
+        printf("No inverse: matrix is singular\n\n");
+        return Matrix<N, N, T>();
+    }
+
+    Matrix<N, N, T> inv = Matrix<N, N, T>::identity();
+    substitute(f, inv);
+    return inv;
+}
+
+template <size_t N, size_t K, typename T>
+template <size_t C>
+Matrix<N, C, T> BandMatrix<N, K, T>::solve(const Matrix<N, C, T> &B) const
+{
+    Factors f;
+    if (!factorize(f))
+    {
+        printf("No solution: matrix is singular\n\n");
+        return Matrix<N, C, T>();
+    }
+
+    Matrix<N, C, T> X{B};
+    substitute(f, X);
+    return X;
+}
+
+// Products
+
+template <size_t N, size_t C, typename T>
+Matrix<N, C, T> operator*(const DiagonalMatrix<N, T> &d, const Matrix<N, C, T> &m)
+{
+    Matrix<N, C, T> res{m};
+    for (size_t i = 0; i < N; ++i)
+        res.multiplyRow(i, d.data[i]);
+
+    return res;
+}
+
+template <size_t R, size_t N, typename T>
+Matrix<R, N, T> operator*(const Matrix<R, N, T> &m, const DiagonalMatrix<N, T> &d)
+{
+    Matrix<R, N, T> res{m};
+    for (size_t i = 0; i < R; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+            res.data[i][j] *= d.data[j];
+    }
+
+    return res;
+}
+
+template <size_t N, typename T>
+DiagonalMatrix<N, T> operator*(const DiagonalMatrix<N, T> &d0, const DiagonalMatrix<N, T> &d1)
+{
+    DiagonalMatrix<N, T> res;
+    for (size_t i = 0; i < N; ++i)
+        res.data[i] = d0.data[i] * d1.data[i];
+
+    return res;
+}
+
+template <size_t N, size_t C, typename T, Triangle S>
+Matrix<N, C, T> operator*(const TriangularMatrix<N, T, S> &t, const Matrix<N, C, T> &m)
+{
+    using Tri = TriangularMatrix<N, T, S>;
+
+    Matrix<N, C, T> res{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        const size_t begin = S == Triangle::upper ? i : 0;
+        const size_t end = S == Triangle::upper ? N : i + 1;
+        for (size_t k = begin; k < end; ++k)
+        {
+            const T a = t.data[Tri::index(i, k)];
+            if (a == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(res.data[i][j], a, m.data[k][j]);
+        }
+    }
+
+    return res;
+}
+
+template <size_t N, typename T, Triangle S>
+TriangularMatrix<N, T, S> operator*(const TriangularMatrix<N, T, S> &t0, const TriangularMatrix<N, T, S> &t1)
+{
+    using Tri = TriangularMatrix<N, T, S>;
+
+    // Cell (i, j) sums over k between i and j only
+    Tri res;
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (!Tri::stored(i, j))
+                continue;
+
+            const size_t begin = S == Triangle::upper ? i : j;
+            const size_t end = S == Triangle::upper ? j : i;
+            T sum{0};
+            for (size_t k = begin; k <= end; ++k)
+                multiplyAdd(sum, t0.data[Tri::index(i, k)], t1.data[Tri::index(k, j)]);
+            res.data[Tri::index(i, j)] = sum;
+        }
+    }
+
+    return res;
+}
+
+template <size_t N, size_t C, typename T>
+Matrix<N, C, T> operator*(const SymmetricMatrix<N, T> &s, const Matrix<N, C, T> &m)
+{
+    // Each stored cell below the diagonal stands for itself and its mirror
+    Matrix<N, C, T> res{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t k = 0; k <= i; ++k)
+        {
+            const T a = s.data[SymmetricMatrix<N, T>::index(i, k)];
+            if (a == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(res.data[i][j], a, m.data[k][j]);
+            if (k == i)
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(res.data[k][j], a, m.data[i][j]);
+        }
+    }
+
+    return res;
+}
+
+template <size_t N, size_t K, size_t C, typename T>
+Matrix<N, C, T> operator*(const BandMatrix<N, K, T> &b, const Matrix<N, C, T> &m)
+{
+    Matrix<N, C, T> res{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        const size_t begin = i > K ? i - K : 0;
+        const size_t end = i + K < N ? i + K : N - 1;
+        for (size_t k = begin; k <= end; ++k)
+        {
+            const T a = b.data[i][k + K - i];
+            if (a == T{0})
+                continue;
+
+            for (size_t j = 0; j < C; ++j)
+                multiplyAdd(res.data[i][j], a, m.data[k][j]);
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Fixed-size pool of worker threads with work stealing. Every worker owns a task
+/// deque: it runs its own tasks newest first, and when it runs out, steals the oldest
+/// task of another worker. Threads waiting on a parallelFor run queued tasks meanwhile,
+/// so parallel loops can be nested, and started from inside a task
+class ThreadPool
+{
+public:
+    /// @brief Constructor with number of worker threads
+    /// @param threads Number of workers, defaults to defaultThreads()
+    explicit ThreadPool(size_t threads = defaultThreads())
+    {
+        if (threads == 0)
+            threads = 1;
+
+        // Every queue exists before any worker starts looking for tasks
+        for (size_t i = 0; i < threads; ++i)
+            queues.emplace_back(new Queue);
+        for (size_t i = 0; i < threads; ++i)
+        {
+            workers.emplace_back([this, i]
+                                 { work(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /// @brief Destructor, finishes queued tasks and joins all workers
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{sleepMutex};
+            stopping = true;
+        }
+        available.notify_all();
+
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+    }
+
+    /// @brief Number of workers used when none is given: the MATRIX_THREADS environment
+    /// variable if set, hardware concurrency otherwise
+    static size_t defaultThreads()
+    {
+        if (const char *env = getenv("MATRIX_THREADS"))
+        {
+            const long n = atol(env);
+            if (n > 0)
+                return n;
+        }
+
+        return std::thread::hardware_concurrency();
+    }
+
+    /// @brief Pool shared by the whole library
+    /// @return Shared pool with defaultThreads() workers
+    static ThreadPool &shared()
+    {
+        static ThreadPool pool{};
+        return pool;
+    }
+
+    /// @brief Number of worker threads
+    size_t size() const { return queues.size(); }
+
+    /// @brief Queue a task
+    /// @param f Callable without arguments
+    /// @return Future holding the task's result
+    template <typename F>
+    auto submit(F &&f) -> std::future<decltype(f())>
+    {
+        using Result = decltype(f());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+        std::future<Result> res = task->get_future();
+        push([task]
+             { (*task)(); });
+
+        return res;
+    }
+
+    /// @brief Runs f over [begin, end) split in chunks of at least grain indices, on every
+    /// worker and on the calling thread. Returns once every chunk has run; the first
+    /// exception thrown by a chunk is rethrown here
+    /// @param begin First index
+    /// @param end One past the last index
+    /// @param grain Smallest chunk
+    /// @param f Callable taking a chunk's first and one past last index
+    template <typename F>
+    void parallelFor(const size_t &begin, const size_t &end, const size_t &grain, F &&f)
+    {
+        if (begin >= end)
+            return;
+
+        // A few chunks per worker, so stealing can even out uneven chunks
+        const size_t n = end - begin;
+        size_t chunks = (size() + 1) * 4;
+        if (grain > 0 && n / grain < chunks)
+            chunks = n / grain;
+        if (chunks > n)
+            chunks = n;
+        if (chunks <= 1)
+        {
+            f(begin, end);
+            return;
+        }
+
+        Loop loop{};
+        loop.remaining = chunks;
+        loop.body = [&f, begin, n, chunks](const size_t &k)
+        {
+            f(begin + n * k / chunks, begin + n * (k + 1) / chunks);
+        };
+
+        // Leave the first chunk to this thread
+        for (size_t k = 1; k < chunks; ++k)
+        {
+            push([&loop, k]
+                 { loop.run(k); });
+        }
+        loop.run(0);
+
+        // Help with queued tasks until every chunk is done
+        while (loop.remaining.load(std::memory_order_acquire) != 0)
+        {
+            if (!runOne())
+                std::this_thread::yield();
+        }
+
+        if (loop.error)
+            std::rethrow_exception(loop.error);
+    }
+
+private:
+    using Task = std::function<void()>;
+
+    /// @brief Task deque of one worker
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /// @brief State shared by the chunks of a parallelFor
+    struct Loop
+    {
+        std::function<void(const size_t &)> body;
+        std::atomic<size_t> remaining;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        void run(const size_t &k)
+        {
+            try
+            {
+                body(k);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if (!error)
+                    error = std::current_exception();
+            }
+            remaining.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    /// @brief Index of the calling thread's queue if it is a worker of this pool, size() otherwise
+    size_t self() const
+    {
+        return currentPool == this ? currentIndex : size();
+    }
+
+    /// @brief Queues a task on the calling worker's deque, or spreads tasks from other threads
+    /// over all deques
+    void push(Task task)
+    {
+        size_t q = self();
+        if (q == size())
+            q = next.fetch_add(1, std::memory_order_relaxed) % size();
+
+        // Counted before it is visible, so a thief can't take it first and underflow the count
+        pending.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock{queues[q]->mutex};
+            queues[q]->tasks.push_back(std::move(task));
+        }
+
+        {
+            // Taking the lock orders this with a worker checking pending before it sleeps
+            std::lock_guard<std::mutex> lock{sleepMutex};
+        }
+        available.notify_one();
+    }
+
+    /// @brief Runs one queued task: the newest of the calling worker's own deque, or else the
+    /// oldest of another deque
+    /// @return Whether a task was found
+    bool runOne()
+    {
+        const size_t own = self();
+        Task task;
+
+        if (own != size())
+        {
+            std::lock_guard<std::mutex> lock{queues[own]->mutex};
+            if (!queues[own]->tasks.empty())
+            {
+                task = std::move(queues[own]->tasks.back());
+                queues[own]->tasks.pop_back();
+            }
+        }
+
+        for (size_t i = 1; !task && i <= size(); ++i)
+        {
+            Queue &victim = *queues[(own + i) % size()];
+            std::lock_guard<std::mutex> lock{victim.mutex};
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+
+        if (!task)
+            return false;
+
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    /// @brief Worker loop, runs tasks until the pool is stopping and every deque is empty
+    void work(const size_t &index)
+    {
+        currentPool = this;
+        currentIndex = index;
+
+        while (true)
+        {
+            if (runOne())
+                continue;
+
+            std::unique_lock<std::mutex> lock{sleepMutex};
+            available.wait(lock, [this]
+                           { return stopping || pending.load(std::memory_order_acquire) != 0; });
+            if (stopping && pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    /// @brief Pool the calling thread works for, if any
+    static inline thread_local const ThreadPool *currentPool = nullptr;
+
+    /// @brief Queue of the calling thread in currentPool
+    static inline thread_local size_t currentIndex = 0;
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> pending{0};
+    std::mutex sleepMutex;
+    std::condition_variable available;
+    bool stopping = false;
+};
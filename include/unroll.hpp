@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+
+// Compile-time unrolling for small fixed-size matrices.
+//
+// unroll<N>(f) expands to f(0); f(1); ... f(N - 1) through a fold expression
+// over std::index_sequence, each index passed as a std::integral_constant so
+// the body can use it in constant expressions. Matrix operations below the
+// thresholds here run their cells this way instead of looping: the result is
+// straight-line code, and since nothing in it calls the runtime-dispatched
+// vector kernels, those operations are constexpr and can build tables at
+// compile time
+
+/// @brief Most cells an element-wise operation or transpose is unrolled over. Larger
+/// matrices loop, and call the vectorized kernels
+constexpr size_t unrollMaximumCells = 16;
+
+/// @brief Most multiply-adds (rows * inner * columns) a product is unrolled over
+constexpr size_t unrollMaximumProduct = 64;
+
+/// @brief Calls f with every index of a sequence, in order
+template <typename F, size_t... I>
+constexpr void unrollSequence(F &f, std::index_sequence<I...>)
+{
+    (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+/// @brief Calls f(0), f(1), ..., f(N - 1) without a loop
+/// @tparam N Number of calls
+/// @param f Callable taking a std::integral_constant<size_t, i>
+template <size_t N, typename F>
+constexpr void unroll(F &&f)
+{
+    unrollSequence(f, std::make_index_sequence<N>{});
+}
@@ -3,6 +3,7 @@
 
 #include <include/fraction.hpp>
 #include <include/matrix.hpp>
+#include <include/dyn_matrix.hpp>
 
 int main(int argc, char **argv)
 {
@@ -51,5 +52,21 @@ int main(int argc, char **argv)
     std::cout << "inv(B) * B:\n"
               << invB * B << "\n";
 
+    // Order only known at runtime, optionally given as first argument
+    const size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 16;
+    DynMatrix<F> C{n, n};
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            C[i][j] = rand() % 3 - 1;
+        }
+    }
+
+    std::cout << "\n==============================";
+    std::cout << "\nC (" << n << "x" << n << "):\n"
+              << C << "\n\n";
+    std::cout << "det(C) = " << C.determinant() << "\n";
+
     return 0;
 }
\ No newline at end of file
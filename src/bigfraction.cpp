@@ -0,0 +1,169 @@
+#include <include/bigfraction.hpp>
+#include <cassert>
+
+BigFraction::BigFraction()
+    : BigFraction{BigInt{1}, BigInt{1}} {}
+
+BigFraction::BigFraction(const int64_t &numerator)
+    : BigFraction{BigInt{numerator}, BigInt{1}} {}
+
+BigFraction::BigFraction(const BigInt &numerator)
+    : BigFraction{numerator, BigInt{1}} {}
+
+BigFraction::BigFraction(const Fraction &f)
+    : BigFraction{BigInt{f.numerator}, BigInt{f.denominator}} {}
+
+BigFraction::BigFraction(const BigInt &numerator, const BigInt &denominator)
+    : numerator{numerator},
+      denominator{denominator}
+{
+    // Denominator can't be zero
+    assert((denominator.sign() != 0) && "Denominator can't be zero");
+    reduce();
+}
+
+BigFraction BigFraction::inverse() const
+{
+    // Numerator can't be zero
+    assert((numerator.sign() != 0) && "Numerator can't be zero");
+    return BigFraction{denominator, numerator};
+}
+
+double BigFraction::eval() const
+{
+    return numerator.toDouble() / denominator.toDouble();
+}
+
+void BigFraction::reduce()
+{
+    // Flip signs if needed
+    if (denominator.sign() < 0)
+    {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+
+    if (numerator.sign() == 0)
+    {
+        denominator = BigInt{1};
+        return;
+    }
+
+    const BigInt s = gcd(numerator, denominator);
+    if (s != BigInt{1})
+    {
+        numerator /= s;
+        denominator /= s;
+    }
+}
+
+bool BigFraction::operator==(const BigFraction &f) const
+{
+    // Both sides are always reduced
+    return numerator == f.numerator && denominator == f.denominator;
+}
+
+bool BigFraction::operator!=(const BigFraction &f) const
+{
+    return !(*this == f);
+}
+
+BigFraction BigFraction::operator+(const BigFraction &f) const
+{
+    BigFraction tmp{*this};
+    tmp += f;
+    return tmp;
+}
+
+BigFraction &BigFraction::operator+=(const BigFraction &f)
+{
+    if (denominator == f.denominator)
+    {
+        numerator += f.numerator;
+    }
+    else
+    {
+        numerator = numerator * f.denominator + denominator * f.numerator;
+        denominator *= f.denominator;
+    }
+    reduce();
+
+    return *this;
+}
+
+BigFraction BigFraction::operator-(const BigFraction &f) const
+{
+    BigFraction tmp{*this};
+    tmp -= f;
+    return tmp;
+}
+
+BigFraction &BigFraction::operator-=(const BigFraction &f)
+{
+    if (denominator == f.denominator)
+    {
+        numerator -= f.numerator;
+    }
+    else
+    {
+        numerator = numerator * f.denominator - denominator * f.numerator;
+        denominator *= f.denominator;
+    }
+    reduce();
+
+    return *this;
+}
+
+BigFraction BigFraction::operator-() const
+{
+    BigFraction tmp{*this};
+    tmp.numerator = -tmp.numerator;
+    return tmp;
+}
+
+BigFraction BigFraction::operator*(const BigFraction &f) const
+{
+    BigFraction tmp{*this};
+    tmp *= f;
+    return tmp;
+}
+
+BigFraction &BigFraction::operator*=(const BigFraction &f)
+{
+    // Cross-reduce before multiplying, so both products are already in lowest terms
+    const BigInt g0 = gcd(numerator, f.denominator);
+    const BigInt g1 = gcd(f.numerator, denominator);
+    numerator = (numerator / g0) * (f.numerator / g1);
+    denominator = (denominator / g1) * (f.denominator / g0);
+
+    if (numerator.sign() == 0)
+        denominator = BigInt{1};
+
+    return *this;
+}
+
+BigFraction BigFraction::operator/(const BigFraction &f) const
+{
+    BigFraction tmp{*this};
+    tmp /= f;
+    return tmp;
+}
+
+BigFraction &BigFraction::operator/=(const BigFraction &f)
+{
+    // Can't divide by zero
+    assert((f.numerator.sign() != 0) && "Can't divide by fraction with numerator zero");
+
+    return *this *= f.inverse();
+}
+
+std::ostream &operator<<(std::ostream &os, const BigFraction &f)
+{
+    os << f.numerator;
+    if (f.numerator.sign() != 0 && f.denominator != BigInt{1})
+    {
+        os << "/" << f.denominator;
+    }
+
+    return os;
+}
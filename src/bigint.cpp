@@ -0,0 +1,591 @@
+#include <include/bigint.hpp>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+using Limbs = std::vector<uint32_t>;
+
+/// @brief Compares two magnitudes
+/// @return -1, 0 or 1
+static int compareMagnitude(const Limbs &a, const Limbs &b)
+{
+    if (a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+
+    for (size_t i = a.size(); i-- > 0;)
+    {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/// @brief Removes leading zero limbs
+static void trim(Limbs &a)
+{
+    while (!a.empty() && a.back() == 0)
+        a.pop_back();
+}
+
+/// @brief Sum of two magnitudes
+static Limbs addMagnitude(const Limbs &a, const Limbs &b)
+{
+    const Limbs &l = a.size() >= b.size() ? a : b;
+    const Limbs &s = a.size() >= b.size() ? b : a;
+
+    Limbs res(l.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < l.size(); ++i)
+    {
+        carry += (uint64_t)l[i] + (i < s.size() ? s[i] : 0);
+        res[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    res[l.size()] = (uint32_t)carry;
+    trim(res);
+
+    return res;
+}
+
+/// @brief Difference of two magnitudes, a must not be smaller than b
+static Limbs subMagnitude(const Limbs &a, const Limbs &b)
+{
+    Limbs res(a.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        int64_t t = (int64_t)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = t < 0;
+        res[i] = (uint32_t)(t + (borrow << 32));
+    }
+    trim(res);
+
+    return res;
+}
+
+/// @brief Schoolbook product of two magnitudes
+static Limbs mulMagnitude(const Limbs &a, const Limbs &b)
+{
+    if (a.empty() || b.empty())
+        return {};
+
+    Limbs res(a.size() + b.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.size(); ++j)
+        {
+            carry += (uint64_t)a[i] * b[j] + res[i + j];
+            res[i + j] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        res[i + b.size()] = (uint32_t)carry;
+    }
+    trim(res);
+
+    return res;
+}
+
+/// @brief Division of a magnitude by a single limb
+/// @return Remainder
+static uint32_t divModLimb(const Limbs &a, const uint32_t &d, Limbs &q)
+{
+    q.assign(a.size(), 0);
+    uint64_t r = 0;
+    for (size_t i = a.size(); i-- > 0;)
+    {
+        const uint64_t cur = (r << 32) | a[i];
+        q[i] = (uint32_t)(cur / d);
+        r = cur % d;
+    }
+    trim(q);
+
+    return (uint32_t)r;
+}
+
+/// @brief Long division of magnitudes, b must be nonzero
+/// Based on: Knuth, TAOCP vol. 2, 4.3.1, Algorithm D
+static void divModMagnitude(const Limbs &a, const Limbs &b, Limbs &q, Limbs &r)
+{
+    assert(!b.empty() && "Division by zero");
+
+    if (compareMagnitude(a, b) < 0)
+    {
+        q.clear();
+        r = a;
+        return;
+    }
+
+    if (b.size() == 1)
+    {
+        const uint32_t rem = divModLimb(a, b[0], q);
+        r.assign(1, rem);
+        trim(r);
+        return;
+    }
+
+    const size_t m = a.size(), n = b.size();
+
+    // Normalize so that the top bit of the divisor is set
+    const int s = __builtin_clz(b[n - 1]);
+    Limbs vn(n), un(m + 1);
+    for (size_t i = n - 1; i > 0; --i)
+        vn[i] = (b[i] << s) | (s ? (uint32_t)((uint64_t)b[i - 1] >> (32 - s)) : 0);
+    vn[0] = b[0] << s;
+    un[m] = s ? (uint32_t)((uint64_t)a[m - 1] >> (32 - s)) : 0;
+    for (size_t i = m - 1; i > 0; --i)
+        un[i] = (a[i] << s) | (s ? (uint32_t)((uint64_t)a[i - 1] >> (32 - s)) : 0);
+    un[0] = a[0] << s;
+
+    q.assign(m - n + 1, 0);
+    for (size_t j = m - n + 1; j-- > 0;)
+    {
+        // Estimate quotient digit from the top two limbs, then correct it
+        const uint64_t num = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+        uint64_t qhat = num / vn[n - 1];
+        uint64_t rhat = num % vn[n - 1];
+        while (qhat >> 32 || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+        {
+            --qhat;
+            rhat += vn[n - 1];
+            if (rhat >> 32)
+                break;
+        }
+
+        // Multiply and subtract
+        int64_t borrow = 0;
+        int64_t t;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint64_t p = qhat * vn[i];
+            t = (int64_t)un[i + j] - borrow - (int64_t)(p & 0xFFFFFFFF);
+            un[i + j] = (uint32_t)t;
+            borrow = (int64_t)(p >> 32) - (t >> 32);
+        }
+        t = (int64_t)un[j + n] - borrow;
+        un[j + n] = (uint32_t)t;
+
+        // Estimate was one too large, add divisor back
+        q[j] = (uint32_t)qhat;
+        if (t < 0)
+        {
+            --q[j];
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                carry += (uint64_t)un[i + j] + vn[i];
+                un[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            un[j + n] += (uint32_t)carry;
+        }
+    }
+    trim(q);
+
+    // Denormalize remainder
+    r.assign(n, 0);
+    for (size_t i = 0; i < n; ++i)
+        r[i] = (un[i] >> s) | (s ? (uint32_t)((uint64_t)un[i + 1] << (32 - s)) : 0);
+    trim(r);
+}
+
+/// @brief Bits [shift, shift + 64) of a magnitude
+static uint64_t extractBits(const Limbs &a, const size_t &shift)
+{
+    uint64_t res = 0;
+    const size_t limb = shift / 32, bit = shift % 32;
+    for (size_t i = 0; i < 3 && limb + i < a.size(); ++i)
+    {
+        const uint64_t v = a[limb + i];
+        const int pos = (int)(32 * i) - (int)bit;
+        if (pos >= 64)
+            break;
+        res |= pos >= 0 ? v << pos : v >> -pos;
+    }
+
+    return res;
+}
+
+/// @brief Binary GCD of two machine words
+/// Based on: https://en.wikipedia.org/wiki/Binary_GCD_algorithm
+static uint64_t binaryGcd(uint64_t a, uint64_t b)
+{
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+
+    const int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b != 0)
+    {
+        b >>= __builtin_ctzll(b);
+        if (a > b)
+            std::swap(a, b);
+        b -= a;
+    }
+
+    return a << shift;
+}
+
+BigInt::BigInt()
+    : BigInt{0} {}
+
+BigInt::BigInt(const int64_t &v)
+    : small{v},
+      negative{false} {}
+
+Limbs BigInt::magnitude() const
+{
+    Limbs scratch;
+    return magnitude(scratch);
+}
+
+const Limbs &BigInt::magnitude(Limbs &scratch) const
+{
+    if (!isSmall())
+        return limbs;
+
+    const uint64_t m = small < 0 ? 0 - (uint64_t)small : (uint64_t)small;
+    scratch.assign({(uint32_t)m, (uint32_t)(m >> 32)});
+    trim(scratch);
+    return scratch;
+}
+
+BigInt BigInt::fromMagnitude(const bool &negative, Limbs &&mag)
+{
+    trim(mag);
+
+    BigInt res{};
+    if (mag.size() <= 2)
+    {
+        const uint64_t m = mag.empty() ? 0 : (mag.size() == 1 ? mag[0] : mag[0] | ((uint64_t)mag[1] << 32));
+        if (!negative && m <= (uint64_t)INT64_MAX)
+        {
+            res.small = (int64_t)m;
+            return res;
+        }
+        if (negative && m <= (uint64_t)INT64_MAX + 1)
+        {
+            res.small = (int64_t)(0 - m);
+            return res;
+        }
+    }
+
+    res.negative = negative;
+    res.limbs = std::move(mag);
+    return res;
+}
+
+int BigInt::sign() const
+{
+    if (isSmall())
+        return (small > 0) - (small < 0);
+
+    return negative ? -1 : 1;
+}
+
+int64_t BigInt::toInt64() const
+{
+    assert(isSmall() && "Integer does not fit in 64 bits");
+    return small;
+}
+
+double BigInt::toDouble() const
+{
+    if (isSmall())
+        return (double)small;
+
+    double res = 0;
+    for (size_t i = limbs.size(); i-- > 0;)
+        res = res * 4294967296.0 + limbs[i];
+
+    return negative ? -res : res;
+}
+
+std::string BigInt::toString() const
+{
+    if (isSmall())
+        return std::to_string(small);
+
+    // Peel off groups of 9 decimal digits
+    std::string res;
+    Limbs mag = limbs, q;
+    while (!mag.empty())
+    {
+        uint32_t chunk = divModLimb(mag, 1000000000, q);
+        mag.swap(q);
+        for (int i = 0; i < 9 && (chunk != 0 || !mag.empty()); ++i)
+        {
+            res.push_back((char)('0' + chunk % 10));
+            chunk /= 10;
+        }
+    }
+    if (negative)
+        res.push_back('-');
+    std::reverse(res.begin(), res.end());
+
+    return res;
+}
+
+size_t BigInt::bitLength() const
+{
+    if (isSmall())
+    {
+        const uint64_t m = small < 0 ? 0 - (uint64_t)small : (uint64_t)small;
+        return m == 0 ? 0 : 64 - __builtin_clzll(m);
+    }
+
+    return 32 * limbs.size() - __builtin_clz(limbs.back());
+}
+
+BigInt BigInt::abs() const
+{
+    return sign() < 0 ? -*this : *this;
+}
+
+bool BigInt::operator==(const BigInt &b) const
+{
+    if (isSmall() && b.isSmall())
+        return small == b.small;
+
+    // Normalized values never mix inline and limb storage for the same number
+    return isSmall() == b.isSmall() && negative == b.negative && limbs == b.limbs;
+}
+
+bool BigInt::operator!=(const BigInt &b) const
+{
+    return !(*this == b);
+}
+
+bool BigInt::operator<(const BigInt &b) const
+{
+    if (isSmall() && b.isSmall())
+        return small < b.small;
+
+    const int sa = sign(), sb = b.sign();
+    if (sa != sb)
+        return sa < sb;
+
+    // Normalized limb values are always larger in magnitude than inline ones
+    int c;
+    if (isSmall() != b.isSmall())
+        c = isSmall() ? -1 : 1;
+    else
+        c = compareMagnitude(limbs, b.limbs);
+
+    return sa < 0 ? c > 0 : c < 0;
+}
+
+bool BigInt::operator<=(const BigInt &b) const
+{
+    return !(b < *this);
+}
+
+bool BigInt::operator>(const BigInt &b) const
+{
+    return b < *this;
+}
+
+bool BigInt::operator>=(const BigInt &b) const
+{
+    return !(*this < b);
+}
+
+BigInt BigInt::addSigned(const BigInt &a, const BigInt &b, const bool &subtract)
+{
+    // Limb results are always freshly allocated, so operands are only borrowed
+    Limbs sa, sb;
+    const Limbs &ma = a.magnitude(sa), &mb = b.magnitude(sb);
+    const bool na = a.sign() < 0, nb = (b.sign() < 0) != subtract;
+    if (na == nb)
+    {
+        return fromMagnitude(na, addMagnitude(ma, mb));
+    }
+    else if (compareMagnitude(ma, mb) >= 0)
+    {
+        return fromMagnitude(na, subMagnitude(ma, mb));
+    }
+    else
+    {
+        return fromMagnitude(nb, subMagnitude(mb, ma));
+    }
+}
+
+BigInt BigInt::operator+(const BigInt &b) const
+{
+    int64_t res;
+    if (isSmall() && b.isSmall() && !__builtin_add_overflow(small, b.small, &res))
+        return BigInt{res};
+
+    return addSigned(*this, b, false);
+}
+
+BigInt &BigInt::operator+=(const BigInt &b)
+{
+    int64_t res;
+    if (isSmall() && b.isSmall() && !__builtin_add_overflow(small, b.small, &res))
+    {
+        small = res;
+        return *this;
+    }
+
+    return *this = addSigned(*this, b, false);
+}
+
+BigInt BigInt::operator-(const BigInt &b) const
+{
+    int64_t res;
+    if (isSmall() && b.isSmall() && !__builtin_sub_overflow(small, b.small, &res))
+        return BigInt{res};
+
+    return addSigned(*this, b, true);
+}
+
+BigInt &BigInt::operator-=(const BigInt &b)
+{
+    int64_t res;
+    if (isSmall() && b.isSmall() && !__builtin_sub_overflow(small, b.small, &res))
+    {
+        small = res;
+        return *this;
+    }
+
+    return *this = addSigned(*this, b, true);
+}
+
+BigInt BigInt::operator-() const
+{
+    if (isSmall() && small != INT64_MIN)
+        return BigInt{-small};
+
+    return fromMagnitude(sign() > 0, magnitude());
+}
+
+BigInt BigInt::operator*(const BigInt &b) const
+{
+    int64_t res;
+    if (isSmall() && b.isSmall() && !__builtin_mul_overflow(small, b.small, &res))
+        return BigInt{res};
+
+    Limbs sa, sb;
+    return fromMagnitude((sign() < 0) != (b.sign() < 0), mulMagnitude(magnitude(sa), b.magnitude(sb)));
+}
+
+BigInt &BigInt::operator*=(const BigInt &b)
+{
+    int64_t res;
+    if (isSmall() && b.isSmall() && !__builtin_mul_overflow(small, b.small, &res))
+    {
+        small = res;
+        return *this;
+    }
+
+    return *this = *this * b;
+}
+
+void divMod(const BigInt &a, const BigInt &b, BigInt &q, BigInt &r)
+{
+    assert((b.sign() != 0) && "Can't divide by zero");
+
+    if (a.isSmall() && b.isSmall() && !(a.small == INT64_MIN && b.small == -1))
+    {
+        const int64_t quot = a.small / b.small;
+        r = BigInt{a.small % b.small};
+        q = BigInt{quot};
+        return;
+    }
+
+    Limbs sa, sb, mq, mr;
+    divModMagnitude(a.magnitude(sa), b.magnitude(sb), mq, mr);
+    const bool na = a.sign() < 0, nb = b.sign() < 0;
+    q = BigInt::fromMagnitude(na != nb, std::move(mq));
+    r = BigInt::fromMagnitude(na, std::move(mr));
+}
+
+BigInt BigInt::operator/(const BigInt &b) const
+{
+    BigInt q, r;
+    divMod(*this, b, q, r);
+    return q;
+}
+
+BigInt &BigInt::operator/=(const BigInt &b)
+{
+    return *this = *this / b;
+}
+
+BigInt BigInt::operator%(const BigInt &b) const
+{
+    BigInt q, r;
+    divMod(*this, b, q, r);
+    return r;
+}
+
+BigInt &BigInt::operator%=(const BigInt &b)
+{
+    return *this = *this % b;
+}
+
+BigInt gcd(const BigInt &a, const BigInt &b)
+{
+    BigInt u = a.abs(), v = b.abs();
+    if (u < v)
+        std::swap(u, v);
+
+    // Lehmer's algorithm: simulate Euclid on the leading 61 bits, then apply
+    // the accumulated cofactors to the full numbers in one step
+    // Based on: Knuth, TAOCP vol. 2, 4.5.2, Algorithm L
+    while (!v.isSmall())
+    {
+        const size_t shift = u.bitLength() - 61;
+        // u >= v and v has limbs, so both can be read in place
+        int64_t x = (int64_t)extractBits(u.limbs, shift);
+        int64_t y = (int64_t)extractBits(v.limbs, shift);
+
+        int64_t A = 1, B = 0, C = 0, D = 1;
+        while (y + C != 0 && y + D != 0)
+        {
+            const int64_t q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D))
+                break;
+
+            int64_t t = A - q * C;
+            A = C;
+            C = t;
+            t = B - q * D;
+            B = D;
+            D = t;
+            t = x - q * y;
+            x = y;
+            y = t;
+        }
+
+        if (B == 0)
+        {
+            // Leading bits were not enough, take a full division step
+            BigInt t = u % v;
+            u = std::move(v);
+            v = std::move(t);
+        }
+        else
+        {
+            BigInt t = u * BigInt{A} + v * BigInt{B};
+            v = u * BigInt{C} + v * BigInt{D};
+            u = std::move(t);
+        }
+    }
+
+    if (v.sign() == 0)
+        return u;
+
+    // Both fit in a machine word after one more division
+    const BigInt r = u % v;
+    return BigInt{(int64_t)binaryGcd((uint64_t)v.toInt64(), (uint64_t)r.toInt64())};
+}
+
+std::ostream &operator<<(std::ostream &os, const BigInt &b)
+{
+    return os << b.toString();
+}